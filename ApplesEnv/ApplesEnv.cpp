@@ -0,0 +1,83 @@
+﻿#include <cstring>
+#include <type_traits>
+#include "apples_env.h"
+#include "VecEnv.h"
+
+static_assert(APPLES_ENV_MODE_LIMITED_APPLES == LIMITED_APPLES && APPLES_ENV_MODE_UNLIMITED_APPLES == UNLIMITED_APPLES
+    && APPLES_ENV_MODE_SPEED_UP == SPEED_UP && APPLES_ENV_MODE_NO_SPEED_UP == NO_SPEED_UP
+    && APPLES_ENV_MODE_CHASE == CHASE && APPLES_ENV_MODE_SWARM == SWARM, "APPLES_ENV_MODE_* must match GameMode");
+static_assert(std::is_same<std::int32_t, int>::value, "actions are passed to VecEnv::step as int");
+
+struct ApplesEnv
+{
+    ApplesEnv(int envCount, int modeMask, int threadCount, bool rasterObservations)
+        : env(envCount, modeMask, threadCount, rasterObservations) {}
+    VecEnv env;
+};
+
+namespace
+{
+    // Исключения не выходят за C-границу
+    ApplesEnv* createEnv(int envCount, int modeMask, int threadCount, bool rasterObservations)
+    {
+        try
+        {
+            return new ApplesEnv(envCount, modeMask, threadCount, rasterObservations);
+        }
+        catch (...)
+        {
+            return nullptr;
+        }
+    }
+}
+
+ApplesEnv* apples_env_create(std::int32_t envCount, std::int32_t modeMask, std::int32_t threadCount)
+{
+    return createEnv(envCount, modeMask, threadCount, false);
+}
+
+ApplesEnv* apples_env_create_with_rasters(std::int32_t envCount, std::int32_t modeMask, std::int32_t threadCount)
+{
+    return createEnv(envCount, modeMask, threadCount, true);
+}
+
+void apples_env_destroy(ApplesEnv* env)
+{
+    delete env;
+}
+
+std::int32_t apples_env_observation_size(void)
+{
+    return VecEnv::OBSERVATION_SIZE;
+}
+
+std::int32_t apples_env_raster_size(void)
+{
+    return VecEnv::RASTER_SIZE;
+}
+
+void apples_env_reset(ApplesEnv* env, std::uint32_t seed, float* observations)
+{
+    const VecEnv::Batch batch = env->env.reset(seed);
+    std::memcpy(observations, batch.observations,
+        sizeof(float) * env->env.getEnvCount() * VecEnv::OBSERVATION_SIZE);
+}
+
+void apples_env_step(ApplesEnv* env, const std::int32_t* actions, float* observations, float* rewards,
+    std::uint8_t* dones)
+{
+    const VecEnv::Batch batch = env->env.step(actions);
+    const int count = env->env.getEnvCount();
+    std::memcpy(observations, batch.observations, sizeof(float) * count * VecEnv::OBSERVATION_SIZE);
+    std::memcpy(rewards, batch.rewards, sizeof(float) * count);
+    std::memcpy(dones, batch.dones, count);
+}
+
+void apples_env_rasters(ApplesEnv* env, std::uint8_t* rasters)
+{
+    const VecEnv::Batch batch = env->env.getBatch();
+    if (batch.rasters)
+    {
+        std::memcpy(rasters, batch.rasters, static_cast<std::size_t>(env->env.getEnvCount()) * VecEnv::RASTER_SIZE);
+    }
+}
@@ -0,0 +1,60 @@
+﻿/*
+C-интерфейс векторной среды VecEnv для привязок из других языков
+(ctypes, cffi, P/Invoke) - библиотека ApplesEnv.dll.
+
+- Чистый C: непрозрачный указатель ApplesEnv и типы <stdint.h>, без
+  заголовков игры и SFML.
+- Буферы выделяет вызывающий: observations - envCount *
+  apples_env_observation_size() float, rewards - envCount float,
+  dones - envCount байт, rasters - envCount * apples_env_raster_size() байт.
+- Режимы партий - маска APPLES_ENV_MODE_* (те же биты, что GameMode).
+- APPLES_ENV_BUILD определен только при сборке самой библиотеки.
+*/
+
+#pragma once
+#include <stdint.h>
+
+#if defined(_WIN32)
+#  if defined(APPLES_ENV_BUILD)
+#    define APPLES_ENV_API __declspec(dllexport)
+#  else
+#    define APPLES_ENV_API __declspec(dllimport)
+#  endif
+#else
+#  define APPLES_ENV_API __attribute__((visibility("default")))
+#endif
+
+#define APPLES_ENV_MODE_LIMITED_APPLES   (1 << 0)
+#define APPLES_ENV_MODE_UNLIMITED_APPLES (1 << 1)
+#define APPLES_ENV_MODE_SPEED_UP         (1 << 2)
+#define APPLES_ENV_MODE_NO_SPEED_UP      (1 << 3)
+#define APPLES_ENV_MODE_CHASE            (1 << 4)
+#define APPLES_ENV_MODE_SWARM            (1 << 5)
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+typedef struct ApplesEnv ApplesEnv;
+
+// threadCount - всего потоков; NULL - среда не создана
+APPLES_ENV_API ApplesEnv* apples_env_create(int32_t envCount, int32_t modeMask, int32_t threadCount);
+// То же, но еще и с растрами занятости (apples_env_rasters)
+APPLES_ENV_API ApplesEnv* apples_env_create_with_rasters(int32_t envCount, int32_t modeMask, int32_t threadCount);
+APPLES_ENV_API void apples_env_destroy(ApplesEnv* env);
+
+APPLES_ENV_API int32_t apples_env_observation_size(void);
+APPLES_ENV_API int32_t apples_env_raster_size(void);
+
+// Новые эпизоды: партия i получает seed + i
+APPLES_ENV_API void apples_env_reset(ApplesEnv* env, uint32_t seed, float* observations);
+// Один тик всех партий; actions - envCount направлений 0..3
+APPLES_ENV_API void apples_env_step(ApplesEnv* env, const int32_t* actions, float* observations, float* rewards,
+    uint8_t* dones);
+// Растры последнего step()/reset(); без растров ничего не пишет
+APPLES_ENV_API void apples_env_rasters(ApplesEnv* env, uint8_t* rasters);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,160 @@
+﻿#include <atomic>
+#include <cstdlib>
+#include <new>
+#include "AllocationTracker.h"
+
+namespace AllocationTracker
+{
+    const char* getSubsystemName(Subsystem subsystem)
+    {
+        switch (subsystem)
+        {
+        case Subsystem::Sim: return "sim";
+        case Subsystem::UI: return "ui";
+        case Subsystem::Audio: return "audio";
+        default: return "other";
+        }
+    }
+}
+
+#ifdef APPLES_ALLOC_TRACKING
+
+namespace
+{
+    // Перед блоком хранится его размер; отступ сохраняет выравнивание max_align_t
+    const std::size_t HEADER_SIZE = alignof(std::max_align_t) > sizeof(std::size_t)
+        ? alignof(std::max_align_t) : sizeof(std::size_t);
+
+    // Счетчики инициализируются константно и доступны до main()
+    struct Counters
+    {
+        std::atomic<std::size_t> allocations{ 0 };
+        std::atomic<std::size_t> frees{ 0 };
+        std::atomic<std::size_t> bytes{ 0 };
+    };
+
+    Counters counters[AllocationTracker::SUBSYSTEM_COUNT];
+    std::atomic<std::size_t> liveBytes{ 0 };
+    std::atomic<std::size_t> framePeakBytes{ 0 };
+    std::atomic<std::size_t> totalPeakBytes{ 0 };
+
+    thread_local AllocationTracker::Subsystem currentSubsystem = AllocationTracker::Subsystem::Audio;
+
+    void raisePeak(std::atomic<std::size_t>& peak, std::size_t value)
+    {
+        std::size_t current = peak.load(std::memory_order_relaxed);
+        while (value > current && !peak.compare_exchange_weak(current, value, std::memory_order_relaxed))
+        {
+        }
+    }
+
+    void* trackedAllocate(std::size_t size)
+    {
+        unsigned char* block = static_cast<unsigned char*>(std::malloc(HEADER_SIZE + size));
+        if (!block) return nullptr;
+        *reinterpret_cast<std::size_t*>(block) = size;
+
+        Counters& counter = counters[static_cast<int>(currentSubsystem)];
+        counter.allocations.fetch_add(1, std::memory_order_relaxed);
+        counter.bytes.fetch_add(size, std::memory_order_relaxed);
+
+        const std::size_t live = liveBytes.fetch_add(size, std::memory_order_relaxed) + size;
+        raisePeak(framePeakBytes, live);
+        raisePeak(totalPeakBytes, live);
+        return block + HEADER_SIZE;
+    }
+
+    void trackedFree(void* pointer)
+    {
+        if (!pointer) return;
+        unsigned char* block = static_cast<unsigned char*>(pointer) - HEADER_SIZE;
+        const std::size_t size = *reinterpret_cast<std::size_t*>(block);
+
+        counters[static_cast<int>(currentSubsystem)].frees.fetch_add(1, std::memory_order_relaxed);
+        liveBytes.fetch_sub(size, std::memory_order_relaxed);
+        std::free(block);
+    }
+
+    void* allocateOrThrow(std::size_t size)
+    {
+        void* pointer = trackedAllocate(size);
+        if (!pointer) throw std::bad_alloc();
+        return pointer;
+    }
+}
+
+namespace AllocationTracker
+{
+    Scope::Scope(Subsystem subsystem) : previous(currentSubsystem)
+    {
+        currentSubsystem = subsystem;
+    }
+
+    Scope::~Scope()
+    {
+        currentSubsystem = previous;
+    }
+
+    void beginFrame()
+    {
+        for (auto& counter : counters)
+        {
+            counter.allocations.store(0, std::memory_order_relaxed);
+            counter.frees.store(0, std::memory_order_relaxed);
+            counter.bytes.store(0, std::memory_order_relaxed);
+        }
+        framePeakBytes.store(liveBytes.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    }
+
+    FrameStats endFrame()
+    {
+        FrameStats stats;
+        for (int i = 0; i < SUBSYSTEM_COUNT; ++i)
+        {
+            stats.subsystems[i].allocations = counters[i].allocations.load(std::memory_order_relaxed);
+            stats.subsystems[i].frees = counters[i].frees.load(std::memory_order_relaxed);
+            stats.subsystems[i].bytes = counters[i].bytes.load(std::memory_order_relaxed);
+        }
+        stats.liveBytes = liveBytes.load(std::memory_order_relaxed);
+        stats.peakBytes = framePeakBytes.load(std::memory_order_relaxed);
+        return stats;
+    }
+
+    std::size_t getPeakBytes()
+    {
+        return totalPeakBytes.load(std::memory_order_relaxed);
+    }
+}
+
+void* operator new(std::size_t size) { return allocateOrThrow(size); }
+void* operator new[](std::size_t size) { return allocateOrThrow(size); }
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept { return trackedAllocate(size); }
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept { return trackedAllocate(size); }
+
+void operator delete(void* pointer) noexcept { trackedFree(pointer); }
+void operator delete[](void* pointer) noexcept { trackedFree(pointer); }
+void operator delete(void* pointer, std::size_t) noexcept { trackedFree(pointer); }
+void operator delete[](void* pointer, std::size_t) noexcept { trackedFree(pointer); }
+void operator delete(void* pointer, const std::nothrow_t&) noexcept { trackedFree(pointer); }
+void operator delete[](void* pointer, const std::nothrow_t&) noexcept { trackedFree(pointer); }
+
+#else
+
+namespace AllocationTracker
+{
+    void beginFrame()
+    {
+    }
+
+    FrameStats endFrame()
+    {
+        return FrameStats();
+    }
+
+    std::size_t getPeakBytes()
+    {
+        return 0;
+    }
+}
+
+#endif
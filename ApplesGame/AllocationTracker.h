@@ -0,0 +1,84 @@
+﻿/*
+Учет выделений памяти в инструментированной сборке (APPLES_ALLOC_TRACKING,
+включен в конфигурации Debug).
+
+- Глобальные operator new/delete заменяются в AllocationTracker.cpp и
+  считают выделения, байты, текущий объем и пик кучи.
+- Выделение относится к подсистеме текущего потока. Основной поток
+  размечает участки кадра через Scope (Sim - ввод и симуляция, UI - рендер);
+  потоки без разметки (потоковое воспроизведение музыки SFML) считаются Audio,
+  загрузчик ресурсов и запись рекордов помечают себя как Other.
+- beginFrame()/endFrame() ограничивают кадр, endFrame() возвращает его
+  статистику для оверлея и журнала.
+- Без APPLES_ALLOC_TRACKING operator new не заменяется, Scope пустой,
+  а статистика всегда нулевая.
+*/
+
+#pragma once
+#include <cstddef>
+
+namespace AllocationTracker
+{
+#ifdef APPLES_ALLOC_TRACKING
+    const bool ENABLED = true;
+#else
+    const bool ENABLED = false;
+#endif
+
+    enum class Subsystem
+    {
+        Sim,
+        UI,
+        Audio,
+        Other
+    };
+    const int SUBSYSTEM_COUNT = 4;
+
+    struct SubsystemStats
+    {
+        std::size_t allocations = 0;
+        std::size_t frees = 0;
+        std::size_t bytes = 0; // выделено за кадр
+    };
+
+    struct FrameStats
+    {
+        SubsystemStats subsystems[SUBSYSTEM_COUNT];
+        std::size_t liveBytes = 0; // занято в куче на конец кадра
+        std::size_t peakBytes = 0; // пик кучи внутри кадра
+
+        const SubsystemStats& operator[](Subsystem subsystem) const
+        {
+            return subsystems[static_cast<int>(subsystem)];
+        }
+    };
+
+    void beginFrame();
+    FrameStats endFrame();
+
+    // Пик кучи за все время работы
+    std::size_t getPeakBytes();
+
+    const char* getSubsystemName(Subsystem subsystem);
+
+    // Относит выделения текущего потока к подсистеме до конца области видимости
+#ifdef APPLES_ALLOC_TRACKING
+    class Scope
+    {
+    public:
+        explicit Scope(Subsystem subsystem);
+        ~Scope();
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+    private:
+        Subsystem previous;
+    };
+#else
+    class Scope
+    {
+    public:
+        explicit Scope(Subsystem) {}
+    };
+#endif
+}
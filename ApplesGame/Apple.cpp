@@ -30,7 +30,7 @@ Apple::Apple(const sf::Color& color)
     shape.setFillColor(color);
 }
 
-void Apple::draw(sf::RenderWindow& window)
+void Apple::draw(CountingRenderTarget& window)
 {
     if (active)
     {
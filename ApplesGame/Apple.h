@@ -42,7 +42,7 @@ public:
     bool active = true;
 
     Apple(const sf::Color& color = sf::Color::Red);
-    void draw(sf::RenderWindow& window) override;
+    void draw(CountingRenderTarget& window) override;
     void setColor(const sf::Color& color);
     
 };
\ No newline at end of file
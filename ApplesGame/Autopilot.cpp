@@ -0,0 +1,173 @@
+﻿#include <algorithm>
+#include <cmath>
+#include "Autopilot.h"
+#include "Constants.h"
+#include "MovementSystem.h"
+
+namespace
+{
+    const float LOOKAHEAD = 0.5f;           // горизонт оценки направления, с
+    const int TARGET_CANDIDATES = 4;        // ближайшие яблоки, проверяемые на достижимость
+    const int RETARGET_TICKS = 240;         // тиков на путь к одной цели
+    const int ENEMY_SAMPLES = 4;            // точки прогноза сближения на горизонте
+    const float DANGER_RADIUS = Constants::PLAYER_SIZE * 2.0f;
+
+    const float FATAL_PENALTY = 1e6f;       // столкновение раньше, чем успеем свернуть
+    const float ENEMY_PENALTY = 1e5f;
+    const float PATH_WEIGHT = 100.0f;       // расхождение с направлением поля
+    const float KEEP_BONUS = 5.0f;          // гистерезис: без дрожания между равными путями
+
+    // Путь центра игрока до касания края экрана (граница как в Game::checkBoundaries)
+    float distanceToBoundary(const sf::Vector2f& position, const sf::Vector2f& heading)
+    {
+        const float limit = Constants::PLAYER_SIZE / 2.0f + 1.0f;
+        if (heading.x > 0.0f) return (Constants::SCREEN_WIDTH - limit - position.x) / heading.x;
+        if (heading.x < 0.0f) return (position.x - limit) / -heading.x;
+        if (heading.y > 0.0f) return (Constants::SCREEN_HEIGHT - limit - position.y) / heading.y;
+        return (position.y - limit) / -heading.y;
+    }
+}
+
+Autopilot::Autopilot()
+{
+    field.init(Constants::SCREEN_WIDTH, Constants::SCREEN_HEIGHT, Constants::FLOW_FIELD_CELL_SIZE);
+}
+
+void Autopilot::setObstacles(const SlotMap<Obstacle>& obstacles)
+{
+    field.setObstacles(obstacles, Constants::PLAYER_SIZE * 0.6f);
+    targetHandle = SlotHandle();
+}
+
+Direction Autopilot::decide(const Player& player, const SpatialQuery& query, const SlotMap<Enemy>& enemies)
+{
+    chooseTarget(player.position, query);
+
+    // Направление пути к цели; без пути - напрямую
+    sf::Vector2f desired = field.getDirection(player.position);
+    if (desired.x == 0.0f && desired.y == 0.0f)
+    {
+        const sf::Vector2f delta = targetPosition - player.position;
+        const float length = std::sqrt(delta.x * delta.x + delta.y * delta.y);
+        if (length > 0.001f) desired = delta / length;
+    }
+
+    // Противники, которые могут оказаться рядом за горизонт оценки
+    const float reach = (player.getSpeed() + Constants::INIT_SPEED) * LOOKAHEAD + DANGER_RADIUS;
+    query.entitiesInRadius(player.position, reach, nearbyEntities);
+
+    Direction best = player.direction;
+    float bestScore = scoreDirection(player, best, desired, query, enemies) - KEEP_BONUS;
+    for (int i = 0; i < 4; ++i)
+    {
+        const Direction direction = static_cast<Direction>(i);
+        if (direction == player.direction) continue;
+
+        const float score = scoreDirection(player, direction, desired, query, enemies);
+        if (score < bestScore)
+        {
+            best = direction;
+            bestScore = score;
+        }
+    }
+    return best;
+}
+
+void Autopilot::chooseTarget(const sf::Vector2f& position, const SpatialQuery& query)
+{
+    if (query.nearestApples(position, TARGET_CANDIDATES, nearestApples) == 0)
+    {
+        targetHandle = SlotHandle();
+        targetPosition = sf::Vector2f(Constants::SCREEN_WIDTH / 2.0f, Constants::SCREEN_HEIGHT / 2.0f);
+        field.update(targetPosition);
+        return;
+    }
+
+    // Текущая цель держится, пока яблоко на месте (съеденное переносится в другую позицию)
+    for (const auto& candidate : nearestApples)
+    {
+        if (candidate.handle != targetHandle || candidate.position != targetPosition) continue;
+        if (++targetTicks <= RETARGET_TICKS)
+        {
+            field.update(targetPosition);
+            return;
+        }
+        skippedHandle = targetHandle;
+        break;
+    }
+
+    // Первое яблоко, до которого есть путь по полю; иначе просто ближайшее.
+    // Поле пересчитывается только здесь, при смене цели
+    const SpatialQuery::Neighbor* chosen = nullptr;
+    for (const auto& candidate : nearestApples)
+    {
+        if (candidate.handle == skippedHandle && nearestApples.size() > 1) continue;
+        if (!chosen) chosen = &candidate;
+
+        field.update(candidate.position);
+        const sf::Vector2f direction = field.getDirection(position);
+        if (direction.x != 0.0f || direction.y != 0.0f)
+        {
+            chosen = &candidate;
+            break;
+        }
+    }
+    if (!chosen) chosen = &nearestApples.front();
+
+    targetHandle = chosen->handle;
+    targetPosition = chosen->position;
+    targetTicks = 0;
+    field.update(targetPosition);
+}
+
+// Меньше - лучше: расхождение с путем к цели плюс штрафы за риск
+float Autopilot::scoreDirection(const Player& player, Direction direction, const sf::Vector2f& desired,
+    const SpatialQuery& query, const SlotMap<Enemy>& enemies) const
+{
+    const float halfSize = Constants::PLAYER_SIZE / 2.0f;
+    const sf::Vector2f heading = directionVector(direction);
+    const sf::Vector2f side(-heading.y, heading.x);
+    const float lookDistance = player.getSpeed() * LOOKAHEAD;
+
+    float score = PATH_WEIGHT * (1.0f - (heading.x * desired.x + heading.y * desired.y));
+
+    // Запас пути: край экрана и лучи по центру и по краям игрока
+    float clear = distanceToBoundary(player.position, heading);
+    const float rayLength = lookDistance + halfSize;
+    SpatialQuery::RayHit hit;
+    for (int ray = -1; ray <= 1; ++ray)
+    {
+        const sf::Vector2f from = player.position + side * (halfSize * ray);
+        if (query.raycastObstacles(from, from + heading * rayLength, hit))
+        {
+            clear = std::min(clear, hit.fraction * rayLength - halfSize);
+        }
+    }
+
+    // За пару тиков игрок должен успеть свернуть
+    const float minClear = player.getSpeed() * 3.0f / 60.0f + 2.0f;
+    if (clear < minClear) score += FATAL_PENALTY;
+
+    // Сближение с противниками: прогноз по их текущей скорости, ближние по времени важнее
+    for (const auto& entity : nearbyEntities)
+    {
+        if (entity.type != CollisionType::Enemy) continue;
+        const Enemy* enemy = enemies.get(entity.handle);
+        if (!enemy) continue;
+
+        for (int sample = 1; sample <= ENEMY_SAMPLES; ++sample)
+        {
+            const float time = LOOKAHEAD * sample / ENEMY_SAMPLES;
+            const sf::Vector2f playerAt = player.position + heading * (player.getSpeed() * time);
+            const sf::Vector2f enemyAt = enemy->position + enemy->velocity * time;
+            const sf::Vector2f delta = playerAt - enemyAt;
+            const float distance = std::sqrt(delta.x * delta.x + delta.y * delta.y);
+            if (distance < DANGER_RADIUS)
+            {
+                const float urgency = 1.0f - 0.5f * (sample - 1) / ENEMY_SAMPLES;
+                score += ENEMY_PENALTY * urgency * (DANGER_RADIUS - distance) / DANGER_RADIUS;
+            }
+        }
+    }
+    return score;
+}
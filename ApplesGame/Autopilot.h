@@ -0,0 +1,50 @@
+﻿/*
+Бот-игрок: заменяет ввод с клавиатуры (attract-режим, прогон --soak).
+
+- Цель - ближайшее достижимое яблоко: из нескольких ближайших (kNearest)
+  берется первое, до которого есть путь по собственному полю потока бота
+  (та же сетка с препятствиями, что у противников в режиме CHASE).
+  Цель держится, пока яблоко на месте; если за RETARGET_TICKS до него не
+  добраться, берется другое.
+- Каждое из четырех направлений оценивается на коротком горизонте
+  (LOOKAHEAD секунд при текущей скорости): согласие с направлением поля,
+  запас до края экрана и препятствий (лучи по центру и краям игрока),
+  сближение с противниками по их текущей скорости.
+- Запросы к миру идут через SpatialQuery, без перебора объектов; буферы
+  запросов переиспользуются между тиками.
+- Стая режима SWARM не учитывается: бот обходит только обычных противников.
+*/
+
+#pragma once
+#include <SFML/System/Vector2.hpp>
+#include <vector>
+#include "Enums.h"
+#include "FlowField.h"
+#include "Player.h"
+#include "SpatialQuery.h"
+
+class Autopilot
+{
+public:
+    Autopilot();
+
+    // Сетка пути бота; вызывается после каждого спавна препятствий
+    void setObstacles(const SlotMap<Obstacle>& obstacles);
+
+    // Направление игрока на текущий тик
+    Direction decide(const Player& player, const SpatialQuery& query, const SlotMap<Enemy>& enemies);
+
+private:
+    FlowField field;
+    std::vector<SpatialQuery::Neighbor> nearestApples;
+    std::vector<SpatialQuery::EntityRef> nearbyEntities;
+
+    SlotHandle targetHandle;
+    sf::Vector2f targetPosition;
+    SlotHandle skippedHandle; // цель, брошенная по таймауту
+    int targetTicks = 0;
+
+    void chooseTarget(const sf::Vector2f& position, const SpatialQuery& query);
+    float scoreDirection(const Player& player, Direction direction, const sf::Vector2f& desired,
+        const SpatialQuery& query, const SlotMap<Enemy>& enemies) const;
+};
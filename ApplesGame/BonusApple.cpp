@@ -24,6 +24,14 @@ ______  _____ _   _ _   _ _____    ___  ____________ _      _____
 
 BonusApple::BonusApple() : Apple(sf::Color::Yellow) {}
 
+//    ,   
+void BonusApple::respawn() 
+{
+    lifeClock.restart();
+    blinkClock.restart();
+    shape.setFillColor(sf::Color::Yellow);
+}
+
 void BonusApple::update() 
 {
     if (blinkClock.getElapsedTime().asSeconds() >= 0.1f) 
@@ -39,6 +39,7 @@ public:
     sf::Clock blinkClock;
 
     BonusApple();
+    void respawn();
     void update();
     bool isExpired() const;
 };
\ No newline at end of file
@@ -0,0 +1,34 @@
+﻿/*
+Контрольные суммы для файлов игры (пакет ресурсов, таблица рекордов).
+*/
+
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+namespace Checksum
+{
+    // CRC-32 (IEEE 802.3)
+    inline std::uint32_t crc32(const void* data, std::size_t size, std::uint32_t crc = 0)
+    {
+        static const struct Table
+        {
+            std::uint32_t values[256];
+            Table()
+            {
+                for (std::uint32_t i = 0; i < 256; ++i)
+                {
+                    std::uint32_t c = i;
+                    for (int k = 0; k < 8; ++k) c = (c & 1) ? (0xEDB88320u ^ (c >> 1)) : (c >> 1);
+                    values[i] = c;
+                }
+            }
+        } table;
+
+        const unsigned char* bytes = static_cast<const unsigned char*>(data);
+        crc = ~crc;
+        for (std::size_t i = 0; i < size; ++i)
+            crc = table.values[(crc ^ bytes[i]) & 0xFF] ^ (crc >> 8);
+        return ~crc;
+    }
+}
@@ -11,6 +11,11 @@
  :
 -     (circleCollide)
 -   - (circleRectCollision)
+-  (swept)      
+  (sweptCircleCircle, sweptCircleRect): t  [0, 1]  
+  from -> to,    ""    
+-   (CollisionEvent):    
+    ,  (, , Game Over)  
 
  :
 1.       
@@ -19,7 +24,19 @@
 */
 
 #pragma once
+#include <algorithm>
+#include <cmath>
 #include "GameObjects.h"
+#include "Enums.h"
+#include "SlotMap.h"
+
+//     
+struct CollisionEvent
+{
+    CollisionType type;
+    SlotHandle target;  //   (   - )
+    float timeOfImpact; //    [0, 1]   
+};
 
 namespace Collision 
 {
@@ -38,4 +55,118 @@ namespace Collision
         sf::Vector2f diff = circle.position - sf::Vector2f(closestX, closestY);
         return (diff.x * diff.x + diff.y * diff.y) < (radius * radius);
     }
+
+    //   (from -> to)   
+    inline bool sweptCircleCircle(const sf::Vector2f& from, const sf::Vector2f& to, float radius,
+        const sf::Vector2f& center, float otherRadius, float& timeOfImpact)
+    {
+        const sf::Vector2f d = to - from;
+        const sf::Vector2f m = from - center;
+        const float radiusSum = radius + otherRadius;
+        const float c = m.x * m.x + m.y * m.y - radiusSum * radiusSum;
+
+        //     
+        if (c <= 0.0f)
+        {
+            timeOfImpact = 0.0f;
+            return true;
+        }
+
+        const float a = d.x * d.x + d.y * d.y;
+        const float b = m.x * d.x + m.y * d.y;
+        if (a <= 0.0f || b >= 0.0f) return false; //     
+
+        const float discriminant = b * b - a * c;
+        if (discriminant < 0.0f) return false;
+
+        const float t = (-b - std::sqrt(discriminant)) / a;
+        if (t > 1.0f) return false;
+
+        timeOfImpact = std::max(t, 0.0f);
+        return true;
+    }
+
+    //  from -> to  AABB ( ), t   [0, 1]
+    inline bool segmentRect(const sf::Vector2f& from, const sf::Vector2f& to,
+        const sf::Vector2f& min, const sf::Vector2f& max, float& timeOfImpact)
+    {
+        const float start[2] = { from.x, from.y };
+        const float delta[2] = { to.x - from.x, to.y - from.y };
+        const float lo[2] = { min.x, min.y };
+        const float hi[2] = { max.x, max.y };
+        float tEnter = 0.0f;
+        float tExit = 1.0f;
+
+        for (int axis = 0; axis < 2; ++axis)
+        {
+            if (std::abs(delta[axis]) < 1e-6f)
+            {
+                if (start[axis] < lo[axis] || start[axis] > hi[axis]) return false;
+                continue;
+            }
+            float t1 = (lo[axis] - start[axis]) / delta[axis];
+            float t2 = (hi[axis] - start[axis]) / delta[axis];
+            if (t1 > t2) std::swap(t1, t2);
+            tEnter = std::max(tEnter, t1);
+            tExit = std::min(tExit, t2);
+            if (tEnter > tExit) return false;
+        }
+
+        timeOfImpact = tEnter;
+        return true;
+    }
+
+    //   (from -> to)   (rectPosition -   ):
+    //    ,   
+    inline bool sweptCircleRect(const sf::Vector2f& from, const sf::Vector2f& to, float radius,
+        const sf::Vector2f& rectPosition, const sf::Vector2f& size, float& timeOfImpact)
+    {
+        const sf::Vector2f rectMax = rectPosition + size;
+
+        //     
+        const float closestX = std::max(rectPosition.x, std::min(from.x, rectMax.x));
+        const float closestY = std::max(rectPosition.y, std::min(from.y, rectMax.y));
+        const float dx = from.x - closestX;
+        const float dy = from.y - closestY;
+        if (dx * dx + dy * dy < radius * radius)
+        {
+            timeOfImpact = 0.0f;
+            return true;
+        }
+
+        bool hit = false;
+        float best = 1.0f;
+        float t = 0.0f;
+
+        // ,     X   Y
+        if (segmentRect(from, to, { rectPosition.x - radius, rectPosition.y },
+            { rectMax.x + radius, rectMax.y }, t) && t <= best)
+        {
+            best = t;
+            hit = true;
+        }
+        if (segmentRect(from, to, { rectPosition.x, rectPosition.y - radius },
+            { rectMax.x, rectMax.y + radius }, t) && t <= best)
+        {
+            best = t;
+            hit = true;
+        }
+
+        //  
+        const sf::Vector2f corners[4] =
+        {
+            rectPosition, { rectMax.x, rectPosition.y }, { rectPosition.x, rectMax.y }, rectMax
+        };
+        for (const auto& corner : corners)
+        {
+            if (sweptCircleCircle(from, to, radius, corner, 0.0f, t) && t <= best)
+            {
+                best = t;
+                hit = true;
+            }
+        }
+
+        if (hit) timeOfImpact = best;
+        return hit;
+    }
 }
\ No newline at end of file
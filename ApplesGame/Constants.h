@@ -21,7 +21,7 @@
    -   (SHAKE_*)
 
 3. :
-   -    (RESOURCES_PATH)
+   -    (RESOURCES_PATH, RESOURCE_PACK)
    -   (BACKGROUND_MUSIC, VOLUME)
 
 4. UI:
@@ -40,6 +40,12 @@
 namespace Constants
 {
     const std::string RESOURCES_PATH = "Resources/";
+    const std::string RESOURCE_PACK = "Resources.pak";
+    const std::string LEADERBOARD_LOG = "leaderboard.log";
+    const std::string LEADERBOARD_SNAPSHOT = "leaderboard.dat";
+    const std::string OCCUPANCY_DUMP = "occupancy.pgm";
+    const std::string CAPTURE_PREFIX = "capture";
+    const int CAPTURE_FRAME_RATE = 30; //      
     const int SCREEN_WIDTH = 800;
     const int SCREEN_HEIGHT = 600;
     const float INIT_SPEED = 100.f;
@@ -87,5 +93,14 @@ namespace Constants
     constexpr float OVERLAY_TITLE_Y_RATIO = 0.20f;
     constexpr float LEADERBOARD_OFFSET_Y = 100.f;
     constexpr float LEADERBOARD_GAP_FROM_TITLE = 60.f;
+    constexpr int LEADERBOARD_VISIBLE_ROWS = 10;
     constexpr int GRID_CELL_SIZE = 128;
+    constexpr int FLOW_FIELD_CELL_SIZE = 20;
+
+    //  SWARM
+    const int SWARM_SIZE = 1500;
+    constexpr float SWARM_RADIUS = 3.0f;
+    constexpr float SWARM_NEIGHBOR_RADIUS = 24.0f;
+    constexpr float SWARM_MAX_SPEED = 90.0f;
+    constexpr float SWARM_SAFE_RADIUS = 150.0f; //      
 }
\ No newline at end of file
@@ -0,0 +1,165 @@
+﻿#include <cstring>
+#include "CountingRenderTarget.h"
+
+namespace
+{
+    const int MAX_PASSES = 8;
+
+    bool isWhitespace(sf::Uint32 c)
+    {
+        return c == ' ' || c == '\t' || c == '\n';
+    }
+
+    // Число вершин текста: 6 на видимый глиф и на линию подчеркивания
+    int textVertices(const sf::Text& text)
+    {
+        const sf::String& string = text.getString();
+        int glyphs = 0;
+        int lines = string.isEmpty() ? 0 : 1;
+        for (std::size_t i = 0; i < string.getSize(); ++i)
+        {
+            if (string[i] == '\n') ++lines;
+            if (!isWhitespace(string[i])) ++glyphs;
+        }
+        const bool underlined = (text.getStyle() & sf::Text::Underlined) != 0;
+        return 6 * (glyphs + (underlined ? lines : 0));
+    }
+}
+
+void CountingRenderTarget::Stats::add(const Stats& other)
+{
+    drawCalls += other.drawCalls;
+    vertices += other.vertices;
+    textureSwitches += other.textureSwitches;
+    blendChanges += other.blendChanges;
+    shaderChanges += other.shaderChanges;
+}
+
+CountingRenderTarget::CountingRenderTarget(sf::RenderTarget& target) : target(target)
+{
+    passes.reserve(MAX_PASSES);
+    lastPasses.reserve(MAX_PASSES);
+    beginFrame();
+}
+
+void CountingRenderTarget::beginFrame()
+{
+    passes.clear();
+    passes.push_back({ "other", Stats() });
+    currentPass = 0;
+    hasPreviousDraw = false;
+}
+
+void CountingRenderTarget::beginPass(const char* name)
+{
+    for (int i = 0; i < static_cast<int>(passes.size()); ++i)
+    {
+        if (std::strcmp(passes[i].name, name) == 0)
+        {
+            currentPass = i;
+            return;
+        }
+    }
+
+    // Лишние проходы учитываются в последнем
+    if (static_cast<int>(passes.size()) >= MAX_PASSES)
+    {
+        currentPass = MAX_PASSES - 1;
+        return;
+    }
+    passes.push_back({ name, Stats() });
+    currentPass = static_cast<int>(passes.size()) - 1;
+}
+
+void CountingRenderTarget::endFrame()
+{
+    lastFrame = Stats();
+    lastPasses.clear();
+    for (const auto& pass : passes)
+    {
+        // Пустой проход по умолчанию не показывается
+        if (pass.stats.drawCalls == 0 && std::strcmp(pass.name, "other") == 0) continue;
+        lastPasses.push_back(pass);
+        lastFrame.add(pass.stats);
+    }
+}
+
+const CountingRenderTarget::Stats* CountingRenderTarget::findPass(const char* name) const
+{
+    for (const auto& pass : lastPasses)
+    {
+        if (std::strcmp(pass.name, name) == 0) return &pass.stats;
+    }
+    return nullptr;
+}
+
+void CountingRenderTarget::dump(std::FILE* out) const
+{
+    std::fprintf(out, "frame: %d draws, %d vertices, %d texture switches, %d blend, %d shader\n",
+        lastFrame.drawCalls, lastFrame.vertices, lastFrame.textureSwitches,
+        lastFrame.blendChanges, lastFrame.shaderChanges);
+    for (const auto& pass : lastPasses)
+    {
+        std::fprintf(out, "  %-8s %4d draws, %6d vertices, %3d texture switches, %d blend, %d shader\n",
+            pass.name, pass.stats.drawCalls, pass.stats.vertices, pass.stats.textureSwitches,
+            pass.stats.blendChanges, pass.stats.shaderChanges);
+    }
+}
+
+void CountingRenderTarget::draw(const sf::Drawable& drawable, const sf::RenderStates& states)
+{
+    // Спрайт, фигура и текст подставляют в states свою текстуру
+    if (const sf::Sprite* sprite = dynamic_cast<const sf::Sprite*>(&drawable))
+    {
+        record(sprite->getTexture(), states, 4, 1);
+    }
+    else if (const sf::Text* text = dynamic_cast<const sf::Text*>(&drawable))
+    {
+        const sf::Font* font = text->getFont();
+        const sf::Texture* texture = font ? &font->getTexture(text->getCharacterSize()) : nullptr;
+        const int vertices = textVertices(*text);
+        const bool outlined = text->getOutlineThickness() != 0.0f;
+        record(texture, states, outlined ? 2 * vertices : vertices, outlined ? 2 : 1);
+    }
+    else if (const sf::Shape* shape = dynamic_cast<const sf::Shape*>(&drawable))
+    {
+        const int points = static_cast<int>(shape->getPointCount());
+        const bool outlined = shape->getOutlineThickness() != 0.0f;
+        const int vertices = (points + 2) + (outlined ? (points + 1) * 2 : 0);
+        record(shape->getTexture(), states, vertices, outlined ? 2 : 1);
+    }
+    else if (const sf::VertexArray* array = dynamic_cast<const sf::VertexArray*>(&drawable))
+    {
+        record(states.texture, states, static_cast<int>(array->getVertexCount()), 1);
+    }
+    else
+    {
+        record(states.texture, states, 0, 1);
+    }
+
+    target.draw(drawable, states);
+}
+
+void CountingRenderTarget::draw(const sf::Vertex* vertices, std::size_t vertexCount,
+    sf::PrimitiveType type, const sf::RenderStates& states)
+{
+    record(states.texture, states, static_cast<int>(vertexCount), 1);
+    target.draw(vertices, vertexCount, type, states);
+}
+
+void CountingRenderTarget::record(const sf::Texture* texture, const sf::RenderStates& states,
+    int vertexCount, int drawCalls)
+{
+    Stats& stats = passes[currentPass].stats;
+    stats.drawCalls += drawCalls;
+    stats.vertices += vertexCount;
+
+    if (!hasPreviousDraw || texture != lastTexture) ++stats.textureSwitches;
+    if (!hasPreviousDraw || states.blendMode != lastBlendMode) ++stats.blendChanges;
+    if (!hasPreviousDraw || states.shader != lastShader) ++stats.shaderChanges;
+
+    lastTexture = texture;
+    lastShader = states.shader;
+    lastBlendMode = states.blendMode;
+    hasPreviousDraw = true;
+}
@@ -0,0 +1,83 @@
+﻿/*
+Фасад над sf::RenderTarget, считающий работу отрисовки кадра.
+
+- Все игровые объекты и UI рисуют через него вместо окна: вызовы draw,
+  вершины, смены текстуры, режима смешивания и шейдера.
+- Статистика ведется по именованным проходам (beginPass("world"), "hud"...)
+  и итогом за кадр; после endFrame() доступна до конца следующего кадра
+  (getLastFrame/findPass) и печатается dump().
+- Вершины и вызовы известных типов (спрайт, фигура, текст, массив вершин)
+  вычисляются так же, как их строит SFML; для прочих Drawable считается
+  один вызов без вершин.
+- Счет смен состояний моделирует кэш SFML приблизительно: смена указателя
+  текстуры/шейдера или режима смешивания между соседними вызовами.
+*/
+
+#pragma once
+#include <SFML/Graphics.hpp>
+#include <cstdio>
+#include <vector>
+
+class CountingRenderTarget
+{
+public:
+    struct Stats
+    {
+        int drawCalls = 0;
+        int vertices = 0;
+        int textureSwitches = 0;
+        int blendChanges = 0;
+        int shaderChanges = 0;
+
+        void add(const Stats& other);
+    };
+
+    struct PassStats
+    {
+        const char* name; // строковый литерал
+        Stats stats;
+    };
+
+    explicit CountingRenderTarget(sf::RenderTarget& target);
+
+    void draw(const sf::Drawable& drawable, const sf::RenderStates& states = sf::RenderStates::Default);
+    void draw(const sf::Vertex* vertices, std::size_t vertexCount, sf::PrimitiveType type,
+        const sf::RenderStates& states = sf::RenderStates::Default);
+
+    void clear(const sf::Color& color = sf::Color::Black) { target.clear(color); }
+    void setView(const sf::View& view) { target.setView(view); }
+    const sf::View& getView() const { return target.getView(); }
+    const sf::View& getDefaultView() const { return target.getDefaultView(); }
+    sf::RenderTarget& getTarget() { return target; }
+
+    // Начало кадра: обнуляет счетчики, текущий проход - "other"
+    void beginFrame();
+
+    // Последующие вызовы учитываются в проходе name
+    void beginPass(const char* name);
+
+    // Конец кадра: итоги становятся доступны через getLastFrame()
+    void endFrame();
+
+    const Stats& getLastFrame() const { return lastFrame; }
+    const std::vector<PassStats>& getLastPasses() const { return lastPasses; }
+    const Stats* findPass(const char* name) const;
+
+    // Печатает итоги последнего кадра по проходам
+    void dump(std::FILE* out) const;
+
+private:
+    sf::RenderTarget& target;
+    std::vector<PassStats> passes;
+    std::vector<PassStats> lastPasses;
+    Stats lastFrame;
+    int currentPass = 0;
+
+    // Состояние предыдущего вызова
+    const sf::Texture* lastTexture = nullptr;
+    const sf::Shader* lastShader = nullptr;
+    sf::BlendMode lastBlendMode;
+    bool hasPreviousDraw = false;
+
+    void record(const sf::Texture* texture, const sf::RenderStates& states, int vertexCount, int drawCalls);
+};
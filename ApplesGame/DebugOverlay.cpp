@@ -0,0 +1,163 @@
+﻿#include <algorithm>
+#include <cstdio>
+#include "DebugOverlay.h"
+
+namespace
+{
+    const int WINDOW_FRAMES = 240;
+    const unsigned CHARACTER_SIZE = 12;
+    const float PANEL_X = 8.0f;
+    const float PANEL_Y = 8.0f;
+    const float PANEL_WIDTH = 330.0f;
+    const float PADDING = 6.0f;
+    const float GRAPH_HEIGHT = 60.0f;
+    const float GRAPH_SCALE_MS = 50.0f;  // время кадра на всю высоту графика
+    const float TARGET_FRAME_MS = 1000.0f / 60.0f;
+    const int TEXT_LINES = 6;
+
+    // Белый пиксель страницы шрифта (SFML резервирует квадрат 2x2 в углу)
+    const sf::Vector2f WHITE_TEXEL(1.0f, 1.0f);
+}
+
+DebugOverlay::DebugOverlay() : history(WINDOW_FRAMES), vertices(sf::Quads)
+{
+    sortedFrameTimes.reserve(WINDOW_FRAMES);
+}
+
+void DebugOverlay::addFrame(const FrameSample& sample)
+{
+    history[head] = sample;
+    head = (head + 1) % WINDOW_FRAMES;
+    count = std::min(count + 1, WINDOW_FRAMES);
+}
+
+float DebugOverlay::percentile(float fraction) const
+{
+    if (sortedFrameTimes.empty()) return 0.0f;
+    const int last = static_cast<int>(sortedFrameTimes.size()) - 1;
+    const int rank = std::min(last, static_cast<int>(fraction * sortedFrameTimes.size()));
+    return sortedFrameTimes[rank];
+}
+
+void DebugOverlay::appendRect(float x, float y, float width, float height, sf::Color color)
+{
+    vertices.append(sf::Vertex(sf::Vector2f(x, y), color, WHITE_TEXEL));
+    vertices.append(sf::Vertex(sf::Vector2f(x + width, y), color, WHITE_TEXEL));
+    vertices.append(sf::Vertex(sf::Vector2f(x + width, y + height), color, WHITE_TEXEL));
+    vertices.append(sf::Vertex(sf::Vector2f(x, y + height), color, WHITE_TEXEL));
+}
+
+// y - базовая линия строки; только ASCII
+void DebugOverlay::appendText(const sf::Font& font, float x, float y, const char* text, sf::Color color)
+{
+    for (const char* c = text; *c; ++c)
+    {
+        const sf::Glyph& glyph = font.getGlyph(static_cast<unsigned char>(*c), CHARACTER_SIZE, false);
+        const sf::FloatRect& bounds = glyph.bounds;
+        const float left = static_cast<float>(glyph.textureRect.left);
+        const float top = static_cast<float>(glyph.textureRect.top);
+        const float right = left + glyph.textureRect.width;
+        const float bottom = top + glyph.textureRect.height;
+
+        const float x0 = x + bounds.left;
+        const float y0 = y + bounds.top;
+        vertices.append(sf::Vertex(sf::Vector2f(x0, y0), color, sf::Vector2f(left, top)));
+        vertices.append(sf::Vertex(sf::Vector2f(x0 + bounds.width, y0), color, sf::Vector2f(right, top)));
+        vertices.append(sf::Vertex(sf::Vector2f(x0 + bounds.width, y0 + bounds.height), color, sf::Vector2f(right, bottom)));
+        vertices.append(sf::Vertex(sf::Vector2f(x0, y0 + bounds.height), color, sf::Vector2f(left, bottom)));
+
+        x += glyph.advance;
+    }
+}
+
+// Столбцы от старых кадров к новым, линия - бюджет кадра 60 FPS
+void DebugOverlay::appendGraph(float x, float y, float width, float height)
+{
+    const float barWidth = width / WINDOW_FRAMES;
+    const int first = (head - count + WINDOW_FRAMES) % WINDOW_FRAMES;
+
+    for (int i = 0; i < count; ++i)
+    {
+        const float frameMs = history[(first + i) % WINDOW_FRAMES].frameMs;
+        const float barHeight = std::min(frameMs / GRAPH_SCALE_MS, 1.0f) * height;
+        const sf::Color color = frameMs <= TARGET_FRAME_MS ? sf::Color(80, 220, 80)
+            : frameMs <= 2.0f * TARGET_FRAME_MS ? sf::Color(230, 200, 60) : sf::Color(230, 70, 60);
+        appendRect(x + i * barWidth, y + height - barHeight, barWidth, barHeight, color);
+    }
+
+    const float targetY = y + height - TARGET_FRAME_MS / GRAPH_SCALE_MS * height;
+    appendRect(x, targetY, width, 1.0f, sf::Color(255, 255, 255, 120));
+}
+
+void DebugOverlay::draw(CountingRenderTarget& target, const sf::Font& font, const SceneStats& scene)
+{
+    if (!visible || count == 0) return;
+
+    // Перцентили и средние update/render по окну
+    sortedFrameTimes.clear();
+    float updateSum = 0.0f;
+    float renderSum = 0.0f;
+    for (int i = 0; i < count; ++i)
+    {
+        sortedFrameTimes.push_back(history[i].frameMs);
+        updateSum += history[i].updateMs;
+        renderSum += history[i].renderMs;
+    }
+    std::sort(sortedFrameTimes.begin(), sortedFrameTimes.end());
+    const FrameSample& last = history[(head + WINDOW_FRAMES - 1) % WINDOW_FRAMES];
+
+    const float lineHeight = CHARACTER_SIZE + 4.0f;
+    const float panelHeight = PADDING * 3 + TEXT_LINES * lineHeight + GRAPH_HEIGHT;
+
+    vertices.clear();
+    appendRect(PANEL_X, PANEL_Y, PANEL_WIDTH, panelHeight, sf::Color(0, 0, 0, 170));
+
+    const sf::Color textColor = sf::Color::White;
+    const float textX = PANEL_X + PADDING;
+    float baseline = PANEL_Y + PADDING + CHARACTER_SIZE;
+    char line[128];
+
+    std::snprintf(line, sizeof(line), "frame %.1f ms  p50 %.1f  p95 %.1f  p99 %.1f",
+        last.frameMs, percentile(0.50f), percentile(0.95f), percentile(0.99f));
+    appendText(font, textX, baseline, line, textColor);
+    baseline += lineHeight;
+
+    std::snprintf(line, sizeof(line), "update %.2f ms  render %.2f ms (avg)",
+        updateSum / count, renderSum / count);
+    appendText(font, textX, baseline, line, textColor);
+    baseline += lineHeight;
+
+    std::snprintf(line, sizeof(line), "draws %d  vertices %d  texture switches %d",
+        last.drawCalls, last.vertices, last.textureSwitches);
+    appendText(font, textX, baseline, line, textColor);
+    baseline += lineHeight;
+
+    std::snprintf(line, sizeof(line), "apples %d  enemies %d  obstacles %d  bonus %d",
+        scene.apples, scene.enemies, scene.obstacles, scene.bonusApples);
+    appendText(font, textX, baseline, line, textColor);
+    baseline += lineHeight;
+
+    std::snprintf(line, sizeof(line), "grid %d/%d cells  max %d per cell  %d entries",
+        scene.grid.occupiedCells, scene.grid.cells, scene.grid.maxPerCell, scene.grid.entries);
+    appendText(font, textX, baseline, line, textColor);
+    baseline += lineHeight;
+
+    if (AllocationTracker::ENABLED)
+    {
+        using AllocationTracker::Subsystem;
+        std::snprintf(line, sizeof(line), "alloc sim %zu  ui %zu  audio %zu  heap %zu KB",
+            scene.allocations[Subsystem::Sim].allocations, scene.allocations[Subsystem::UI].allocations,
+            scene.allocations[Subsystem::Audio].allocations, scene.allocations.liveBytes / 1024);
+    }
+    else std::snprintf(line, sizeof(line), "alloc tracking off");
+    appendText(font, textX, baseline, line, textColor);
+    baseline += lineHeight;
+
+    appendGraph(textX, baseline - CHARACTER_SIZE + PADDING, PANEL_WIDTH - 2 * PADDING, GRAPH_HEIGHT);
+
+    // Оверлей не зависит от тряски камеры
+    const sf::View view = target.getView();
+    target.setView(target.getDefaultView());
+    target.draw(vertices, sf::RenderStates(&font.getTexture(CHARACTER_SIZE)));
+    target.setView(view);
+}
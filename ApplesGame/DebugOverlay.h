@@ -0,0 +1,67 @@
+﻿/*
+Отладочный оверлей производительности (включается клавишей F3).
+
+- Время кадра p50/p95/p99 по скользящему окну последних кадров и график
+  времени кадра, доля update/render, вызовы отрисовки, число объектов,
+  заполненность SpatialGrid и выделения памяти за кадр.
+- Весь оверлей (подложка, график и текст) собирается в один sf::VertexArray
+  и выводится одним вызовом draw с текстурой шрифта: глифы берутся из
+  sf::Font::getGlyph, сплошные прямоугольники используют белый пиксель,
+  который SFML резервирует в углу каждой страницы шрифта.
+- Буферы переиспользуются между кадрами; после прогрева кэша глифов
+  оверлей не выделяет память.
+*/
+
+#pragma once
+#include <SFML/Graphics.hpp>
+#include <vector>
+#include "AllocationTracker.h"
+#include "SpatialGrid.h"
+#include "CountingRenderTarget.h"
+
+class DebugOverlay
+{
+public:
+    struct FrameSample
+    {
+        float frameMs = 0.0f;
+        float updateMs = 0.0f;
+        float renderMs = 0.0f;
+        int drawCalls = 0;
+        int vertices = 0;
+        int textureSwitches = 0;
+    };
+
+    struct SceneStats
+    {
+        int apples = 0;
+        int enemies = 0;
+        int obstacles = 0;
+        int bonusApples = 0;
+        SpatialGrid::Occupancy grid;
+        AllocationTracker::FrameStats allocations;
+    };
+
+    DebugOverlay();
+
+    void toggle() { visible = !visible; }
+    bool isVisible() const { return visible; }
+
+    // Кадр попадает в окно статистики, даже если оверлей скрыт
+    void addFrame(const FrameSample& sample);
+
+    void draw(CountingRenderTarget& target, const sf::Font& font, const SceneStats& scene);
+
+private:
+    std::vector<FrameSample> history; // кольцевой буфер
+    int head = 0;
+    int count = 0;
+    std::vector<float> sortedFrameTimes;
+    sf::VertexArray vertices;
+    bool visible = false;
+
+    float percentile(float fraction) const;
+    void appendRect(float x, float y, float width, float height, sf::Color color);
+    void appendText(const sf::Font& font, float x, float y, const char* text, sf::Color color);
+    void appendGraph(float x, float y, float width, float height);
+};
@@ -0,0 +1,32 @@
+﻿/*
+Счетчики игровых объектов, которые поддерживаются инкрементально.
+
+- Обновляются в точках изменения мира: спавн, съедание, респавн, сброс.
+- Проверка победы и значения HUD читаются за O(1) без обхода контейнеров.
+*/
+
+#pragma once
+
+struct EntityCounters
+{
+    int activeApples = 0; // яблоки на поле
+    int eatenApples = 0;  // съедено за партию
+    int obstacles = 0;
+    int enemies = 0;
+    int bonusApples = 0;
+
+    void onApplesSpawned(int count)
+    {
+        activeApples = count;
+        eatenApples = 0;
+    }
+
+    // respawned - яблоко сразу появилось в новом месте (UNLIMITED_APPLES)
+    void onAppleEaten(bool respawned)
+    {
+        ++eatenApples;
+        if (!respawned) --activeApples;
+    }
+
+    bool allApplesCollected() const { return activeApples == 0; }
+};
@@ -14,10 +14,11 @@
 
 2. GameState -  :
    * MAIN_MENU / PLAYING / PAUSED / GAME_OVER / WIN
+   * LOADING -      
    *      
 
 3. CollisionType -  :
-   * Obstacle/Boundary/Apple/Enemy
+   * Obstacle/Boundary/Apple/Enemy/BonusApple
    *      
 
 4. MenuAction -   :
@@ -30,9 +31,12 @@
    * UNLIMITED_APPLES        .
    * SPEED_UP                 .
    * NO_SPEED_UP          ,  .
+   * CHASE                     (FlowField).
+   * SWARM                     (Swarm).
 
     :
 -       .
+- GameModePolicy -        .
 -  
 -  
 */
@@ -40,8 +44,8 @@
 #pragma once
 
 enum class Direction { Right, Up, Left, Down };
-enum GameState { MAIN_MENU, LEADERBOARD, PLAYING, PAUSED, GAME_OVER, WIN };
-enum class CollisionType { Obstacle, Boundary, Apple, Enemy };
+enum GameState { MAIN_MENU, LEADERBOARD, PLAYING, PAUSED, GAME_OVER, WIN, LOADING };
+enum class CollisionType { Obstacle, Boundary, Apple, Enemy, BonusApple };
 enum class MenuAction { START_GAME, EXIT, CONTINUE, RESTART, MAIN_MENU, NONE, SHOW_LEADERBOARD };
 enum GameMode 
 {
@@ -49,10 +53,23 @@ enum GameMode
 	LIMITED_APPLES	 = 1 << 0, //   
 	UNLIMITED_APPLES = 1 << 1, //   
 	SPEED_UP		 = 1 << 2, //  
-	NO_SPEED_UP		 = 1 << 3  //   
+	NO_SPEED_UP		 = 1 << 3, //   
+	CHASE			 = 1 << 4, //   
+	SWARM			 = 1 << 5  //   
 };
 
 inline bool HasGameMode(int modeMask, GameMode mode) 
 {
 	return (modeMask & mode) != 0;
-}
\ No newline at end of file
+}
+
+//     :       
+template <bool LimitedApples, bool UnlimitedApples, bool SpeedUp, bool Chase, bool Swarm>
+struct GameModePolicy
+{
+	static constexpr bool limitedApples = LimitedApples;
+	static constexpr bool unlimitedApples = UnlimitedApples;
+	static constexpr bool speedUp = SpeedUp;
+	static constexpr bool chase = Chase;
+	static constexpr bool swarm = Swarm;
+};
\ No newline at end of file
@@ -0,0 +1,162 @@
+﻿#include <algorithm>
+#include <cmath>
+#include <limits>
+#include "FlowField.h"
+
+namespace
+{
+    const int UNREACHABLE = -1;
+
+    // Сначала прямые соседи, затем диагональные
+    const int NEIGHBOR_DX[8] = { 1, 0, -1, 0, 1, -1, -1, 1 };
+    const int NEIGHBOR_DY[8] = { 0, -1, 0, 1, -1, -1, 1, 1 };
+}
+
+void FlowField::init(int screenWidth, int screenHeight, int size)
+{
+    cellSize = size > 0 ? size : 20;
+    cols = (screenWidth + cellSize - 1) / cellSize;
+    rows = (screenHeight + cellSize - 1) / cellSize;
+
+    const std::size_t count = static_cast<std::size_t>(cols) * rows;
+    blocked.assign(count, 0);
+    distance.assign(count, UNREACHABLE);
+    next.assign(count, -1);
+    queue.assign(count, 0);
+    targetCell = -1;
+    dirty = true;
+}
+
+void FlowField::setObstacles(const SlotMap<Obstacle>& obstacles, float inflateRadius)
+{
+    std::fill(blocked.begin(), blocked.end(), 0);
+
+    for (const auto& obstacle : obstacles)
+    {
+        const sf::Vector2f size = obstacle.getSize();
+        const float left = obstacle.position.x - inflateRadius;
+        const float top = obstacle.position.y - inflateRadius;
+        const float right = obstacle.position.x + size.x + inflateRadius;
+        const float bottom = obstacle.position.y + size.y + inflateRadius;
+
+        const int minCol = std::max(0, static_cast<int>(std::floor(left / cellSize)));
+        const int minRow = std::max(0, static_cast<int>(std::floor(top / cellSize)));
+        const int maxCol = std::min(cols - 1, static_cast<int>(std::floor(right / cellSize)));
+        const int maxRow = std::min(rows - 1, static_cast<int>(std::floor(bottom / cellSize)));
+
+        for (int row = minRow; row <= maxRow; ++row)
+        {
+            for (int col = minCol; col <= maxCol; ++col) blocked[row * cols + col] = 1;
+        }
+    }
+    dirty = true;
+}
+
+int FlowField::cellIndexFor(const sf::Vector2f& position) const
+{
+    const int col = std::min(std::max(static_cast<int>(position.x) / cellSize, 0), cols - 1);
+    const int row = std::min(std::max(static_cast<int>(position.y) / cellSize, 0), rows - 1);
+    return row * cols + col;
+}
+
+sf::Vector2f FlowField::cellCenter(int index) const
+{
+    return sf::Vector2f((index % cols + 0.5f) * cellSize, (index / cols + 0.5f) * cellSize);
+}
+
+void FlowField::update(const sf::Vector2f& target)
+{
+    if (cols == 0) return;
+
+    targetPosition = target;
+    const int cell = cellIndexFor(target);
+    if (!dirty && cell == targetCell) return;
+
+    targetCell = cell;
+    dirty = false;
+    computeDistances();
+    computeNextCells();
+}
+
+// Обход в ширину от клетки цели по прямым соседям
+void FlowField::computeDistances()
+{
+    std::fill(distance.begin(), distance.end(), UNREACHABLE);
+
+    int head = 0;
+    int tail = 0;
+    distance[targetCell] = 0;
+    queue[tail++] = targetCell;
+
+    while (head < tail)
+    {
+        const int current = queue[head++];
+        const int col = current % cols;
+        const int row = current / cols;
+
+        for (int i = 0; i < 4; ++i)
+        {
+            const int c = col + NEIGHBOR_DX[i];
+            const int r = row + NEIGHBOR_DY[i];
+            if (c < 0 || c >= cols || r < 0 || r >= rows) continue;
+
+            const int neighbor = r * cols + c;
+            if (blocked[neighbor] || distance[neighbor] != UNREACHABLE) continue;
+
+            distance[neighbor] = distance[current] + 1;
+            queue[tail++] = neighbor;
+        }
+    }
+}
+
+// Следующая клетка - сосед с наименьшим расстоянием; диагональ только
+// если обе прямые клетки рядом свободны
+void FlowField::computeNextCells()
+{
+    for (int index = 0; index < cols * rows; ++index)
+    {
+        const int col = index % cols;
+        const int row = index / cols;
+        // Из свободной клетки - только ближе к цели, из заблокированной - в любую достижимую
+        int best = -1;
+        int bestDistance = blocked[index] ? std::numeric_limits<int>::max() : distance[index];
+
+        for (int i = 0; bestDistance != UNREACHABLE && i < 8; ++i)
+        {
+            const int c = col + NEIGHBOR_DX[i];
+            const int r = row + NEIGHBOR_DY[i];
+            if (c < 0 || c >= cols || r < 0 || r >= rows) continue;
+
+            const int neighbor = r * cols + c;
+            if (distance[neighbor] == UNREACHABLE) continue;
+
+            if (i >= 4 && (blocked[row * cols + c] || blocked[r * cols + col])) continue;
+
+            if (distance[neighbor] < bestDistance)
+            {
+                best = neighbor;
+                bestDistance = distance[neighbor];
+            }
+        }
+        next[index] = best;
+    }
+}
+
+sf::Vector2f FlowField::getDirection(const sf::Vector2f& position) const
+{
+    if (cols == 0) return sf::Vector2f();
+
+    // В клетке цели - прямо к ней
+    const int cell = cellIndexFor(position);
+    sf::Vector2f goal = targetPosition;
+    if (cell != targetCell)
+    {
+        if (next[cell] < 0) return sf::Vector2f();
+        goal = cellCenter(next[cell]);
+    }
+
+    const sf::Vector2f delta = goal - position;
+    const float length = std::sqrt(delta.x * delta.x + delta.y * delta.y);
+    if (length < 0.001f) return sf::Vector2f();
+    return delta / length;
+}
@@ -0,0 +1,52 @@
+﻿/*
+Поле потока к игроку для режима преследования (CHASE).
+
+- Экран делится на клетки; клетка заблокирована, если пересекается с
+  препятствием, расширенным на радиус противника (setObstacles).
+- update(target) пересчитывает поле обходом в ширину от клетки игрока
+  только когда игрок перешел в другую клетку или сменились препятствия.
+- Для каждой клетки хранится следующая клетка пути (8 соседей, без срезания
+  углов препятствий); противник читает направление за O(1) и не ищет
+  путь сам.
+- Из заблокированной клетки (противник у края препятствия) путь ведет
+  в ближайшую свободную соседнюю клетку.
+*/
+
+#pragma once
+#include <SFML/System/Vector2.hpp>
+#include <vector>
+#include "Obstacle.h"
+#include "SlotMap.h"
+
+class FlowField
+{
+public:
+    void init(int screenWidth, int screenHeight, int cellSize);
+
+    // Отмечает заблокированные клетки; поле будет пересчитано в update()
+    void setObstacles(const SlotMap<Obstacle>& obstacles, float inflateRadius);
+
+    // Пересчет, если цель сменила клетку
+    void update(const sf::Vector2f& target);
+
+    // Единичный вектор движения из position к цели (нулевой, если пути нет)
+    sf::Vector2f getDirection(const sf::Vector2f& position) const;
+
+private:
+    int cellSize = 20;
+    int cols = 0;
+    int rows = 0;
+    int targetCell = -1;
+    sf::Vector2f targetPosition;
+    bool dirty = true;
+
+    std::vector<unsigned char> blocked;
+    std::vector<int> distance;
+    std::vector<int> next;   // следующая клетка пути или -1
+    std::vector<int> queue;  // очередь обхода, выделяется один раз
+
+    int cellIndexFor(const sf::Vector2f& position) const;
+    sf::Vector2f cellCenter(int index) const;
+    void computeDistances();
+    void computeNextCells();
+};
@@ -0,0 +1,91 @@
+﻿#include <algorithm>
+#include <cstdarg>
+#include <cstdint>
+#include <cstdio>
+#include <new>
+#include "FrameArena.h"
+
+FrameArena::FrameArena(std::size_t capacity)
+    : buffer(new unsigned char[capacity]), capacity(capacity)
+{
+}
+
+FrameArena::~FrameArena()
+{
+    releaseOverflow();
+}
+
+void* FrameArena::allocate(std::size_t size, std::size_t alignment)
+{
+    ++frameAllocations;
+
+    const std::uintptr_t base = reinterpret_cast<std::uintptr_t>(buffer.get());
+    const std::uintptr_t aligned = (base + offset + alignment - 1) & ~(static_cast<std::uintptr_t>(alignment) - 1);
+    const std::size_t start = static_cast<std::size_t>(aligned - base);
+
+    if (start + size > capacity)
+    {
+        return allocateOverflow(size);
+    }
+
+    offset = start + size;
+    peakBytes = std::max(peakBytes, offset);
+    return buffer.get() + start;
+}
+
+// Буфер кадра переполнен: блок из кучи, живет до reset()
+void* FrameArena::allocateOverflow(std::size_t size)
+{
+    ++frameHeapFallbacks;
+    ++totalHeapFallbacks;
+
+    const std::size_t header = sizeof(std::max_align_t);
+    unsigned char* block = static_cast<unsigned char*>(::operator new(header + size));
+    OverflowBlock* node = reinterpret_cast<OverflowBlock*>(block);
+    node->next = overflow;
+    overflow = node;
+    return block + header;
+}
+
+void FrameArena::releaseOverflow()
+{
+    while (overflow)
+    {
+        OverflowBlock* next = overflow->next;
+        ::operator delete(overflow);
+        overflow = next;
+    }
+}
+
+const char* FrameArena::format(const char* fmt, ...)
+{
+    va_list args;
+    va_start(args, fmt);
+    va_list argsCopy;
+    va_copy(argsCopy, args);
+    const int length = std::vsnprintf(nullptr, 0, fmt, args);
+    va_end(args);
+
+    if (length < 0)
+    {
+        va_end(argsCopy);
+        return "";
+    }
+
+    char* text = static_cast<char*>(allocate(static_cast<std::size_t>(length) + 1, 1));
+    std::vsnprintf(text, static_cast<std::size_t>(length) + 1, fmt, argsCopy);
+    va_end(argsCopy);
+    return text;
+}
+
+void FrameArena::reset()
+{
+    lastFrameBytes = offset;
+    lastFrameAllocations = frameAllocations;
+    lastFrameHeapFallbacks = frameHeapFallbacks;
+
+    releaseOverflow();
+    offset = 0;
+    frameAllocations = 0;
+    frameHeapFallbacks = 0;
+}
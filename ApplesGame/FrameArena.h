@@ -0,0 +1,66 @@
+﻿/*
+Линейный аллокатор временных данных кадра.
+
+- allocate() сдвигает указатель в заранее выделенном буфере, освобождения
+  по одному нет: reset() в конце кадра (после window.display()) отдает
+  всю память сразу.
+- Если буфер кончился, память берется из глобальной кучи и возвращается
+  в reset(); такие обращения считаются (getHeapFallbacks) - в устоявшемся
+  кадре их быть не должно.
+- Строки кадра (счет, строки таблиц) - format(): текст сразу уходит в
+  кэшированные sf::Text через setTextIfChanged, контейнеры кадра не нужны.
+*/
+
+#pragma once
+#include <cstddef>
+#include <memory>
+
+class FrameArena
+{
+public:
+    explicit FrameArena(std::size_t capacity = 64 * 1024);
+    ~FrameArena();
+    FrameArena(const FrameArena&) = delete;
+    FrameArena& operator=(const FrameArena&) = delete;
+
+    void* allocate(std::size_t size, std::size_t alignment = alignof(std::max_align_t));
+
+    // Строка printf-формата в памяти кадра (действительна до reset())
+    const char* format(const char* fmt, ...);
+
+    // Конец кадра: освобождает все выделения и запоминает статистику кадра
+    void reset();
+
+    std::size_t getCapacity() const { return capacity; }
+    std::size_t getPeakBytes() const { return peakBytes; }
+
+    // Статистика последнего завершенного кадра
+    std::size_t getLastFrameBytes() const { return lastFrameBytes; }
+    std::size_t getLastFrameAllocations() const { return lastFrameAllocations; }
+    std::size_t getLastFrameHeapFallbacks() const { return lastFrameHeapFallbacks; }
+
+    // Обращения к глобальной куче за все время
+    std::size_t getHeapFallbacks() const { return totalHeapFallbacks; }
+
+private:
+    struct OverflowBlock
+    {
+        OverflowBlock* next;
+    };
+
+    std::unique_ptr<unsigned char[]> buffer;
+    std::size_t capacity;
+    std::size_t offset = 0;
+    std::size_t peakBytes = 0;
+    OverflowBlock* overflow = nullptr;
+
+    std::size_t frameAllocations = 0;
+    std::size_t frameHeapFallbacks = 0;
+    std::size_t lastFrameBytes = 0;
+    std::size_t lastFrameAllocations = 0;
+    std::size_t lastFrameHeapFallbacks = 0;
+    std::size_t totalHeapFallbacks = 0;
+
+    void* allocateOverflow(std::size_t size);
+    void releaseOverflow();
+};
@@ -0,0 +1,367 @@
+﻿#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <iterator>
+#include "FrameCapture.h"
+#include "AllocationTracker.h"
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#endif
+#include <SFML/OpenGL.hpp>
+
+#ifndef APIENTRY
+#define APIENTRY
+#endif
+
+namespace
+{
+    // GL 1.5: в gl.h Windows их нет, адреса - у драйвера
+    const GLenum PIXEL_PACK_BUFFER = 0x88EB;
+    const GLenum STREAM_READ = 0x88E1;
+    const GLenum READ_ONLY = 0x88B8;
+
+    struct PixelBufferFunctions
+    {
+        typedef void (APIENTRY* GenBuffers)(GLsizei, GLuint*);
+        typedef void (APIENTRY* DeleteBuffers)(GLsizei, const GLuint*);
+        typedef void (APIENTRY* BindBuffer)(GLenum, GLuint);
+        typedef void (APIENTRY* BufferData)(GLenum, std::ptrdiff_t, const void*, GLenum);
+        typedef void* (APIENTRY* MapBuffer)(GLenum, GLenum);
+        typedef GLboolean (APIENTRY* UnmapBuffer)(GLenum);
+
+        GenBuffers genBuffers = nullptr;
+        DeleteBuffers deleteBuffers = nullptr;
+        BindBuffer bindBuffer = nullptr;
+        BufferData bufferData = nullptr;
+        MapBuffer mapBuffer = nullptr;
+        UnmapBuffer unmapBuffer = nullptr;
+        bool loaded = false;
+
+        // Нужен активный контекст; false - PBO недоступны
+        bool load()
+        {
+            if (loaded) return genBuffers != nullptr;
+            loaded = true;
+            genBuffers = reinterpret_cast<GenBuffers>(sf::Context::getFunction("glGenBuffers"));
+            deleteBuffers = reinterpret_cast<DeleteBuffers>(sf::Context::getFunction("glDeleteBuffers"));
+            bindBuffer = reinterpret_cast<BindBuffer>(sf::Context::getFunction("glBindBuffer"));
+            bufferData = reinterpret_cast<BufferData>(sf::Context::getFunction("glBufferData"));
+            mapBuffer = reinterpret_cast<MapBuffer>(sf::Context::getFunction("glMapBuffer"));
+            unmapBuffer = reinterpret_cast<UnmapBuffer>(sf::Context::getFunction("glUnmapBuffer"));
+            if (!genBuffers || !deleteBuffers || !bindBuffer || !bufferData || !mapBuffer || !unmapBuffer)
+            {
+                genBuffers = nullptr;
+                std::printf("Capture: pixel buffer objects unavailable, using synchronous glReadPixels\n");
+            }
+            return genBuffers != nullptr;
+        }
+    };
+
+    PixelBufferFunctions gl;
+}
+
+const int FrameCapture::READBACK_SLOTS;
+
+FrameCapture::FrameCapture(int bufferCount)
+    : bufferCount(std::max(2, bufferCount))
+{
+}
+
+FrameCapture::~FrameCapture()
+{
+    stop();
+}
+
+bool FrameCapture::start(const std::string& prefix, int width, int height, Format format, Layer layer, int frameRate)
+{
+    stop();
+
+    if (format == Format::RAW_VIDEO)
+    {
+        rawFile = std::fopen((prefix + ".rgba").c_str(), "wb");
+        if (!rawFile) return false;
+    }
+
+    this->prefix = prefix;
+    this->width = width;
+    this->height = height;
+    this->format = format;
+    this->layer = layer;
+    frameInterval = frameRate > 0
+        ? std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double>(1.0 / frameRate))
+        : std::chrono::steady_clock::duration::zero();
+    sessionStart = std::chrono::steady_clock::now();
+    nextFrameTime = sessionStart;
+    queuedFrames = 0;
+    writtenFrames.store(0);
+    droppedFrames.store(0);
+
+    // Все буферы сразу: во время записи поток рендера память не выделяет
+    const std::size_t frameSize = static_cast<std::size_t>(width) * height * 4;
+    buffers.resize(bufferCount);
+    freeBuffers.clear();
+    freeBuffers.reserve(bufferCount);
+    for (int i = 0; i < bufferCount; ++i)
+    {
+        buffers[i].resize(frameSize);
+        freeBuffers.push_back(i);
+    }
+    pending.resize(bufferCount);
+    pendingHead = 0;
+    pendingCount = 0;
+
+    readbackTried = false;
+    readbackReady = false;
+    readbackSlot = 0;
+    std::fill(std::begin(readbackFilled), std::end(readbackFilled), false);
+
+    stopRequested = false;
+    active = true;
+    worker = std::thread(&FrameCapture::writerLoop, this);
+    return true;
+}
+
+void FrameCapture::stop()
+{
+    if (!active) return;
+
+    // Кадры, еще лежащие в PBO, - в очередь; в конце записи ждать можно
+    if (readbackReady && sf::Context::getActiveContextId() != 0)
+    {
+        for (int i = 0; i < READBACK_SLOTS; ++i)
+        {
+            const int slot = (readbackSlot + i) % READBACK_SLOTS;
+            if (readbackFilled[slot]) collectReadback(slot, true);
+        }
+        releasePackBuffers();
+    }
+    readbackReady = false;
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopRequested = true;
+    }
+    wakeUp.notify_one();
+    if (worker.joinable()) worker.join();
+    active = false;
+
+    if (rawFile)
+    {
+        std::fclose(rawFile);
+        rawFile = nullptr;
+
+        // Частота ролика - сколько кадров реально записано за секунду сеанса
+        const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - sessionStart).count();
+        const double frameRate = seconds > 0.0 ? writtenFrames.load() / seconds : 0.0;
+        std::printf("Capture: %d frames to %s.rgba in %.1f s (%.2f fps), %d dropped "
+            "(ffmpeg -f rawvideo -pix_fmt rgba -s %dx%d -r %.2f -i %s.rgba)\n",
+            writtenFrames.load(), prefix.c_str(), seconds, frameRate, droppedFrames.load(), width, height,
+            frameRate, prefix.c_str());
+    }
+    else
+    {
+        std::printf("Capture: %d frames to %s_*.png, %d dropped\n",
+            writtenFrames.load(), prefix.c_str(), droppedFrames.load());
+    }
+}
+
+bool FrameCapture::captureWindow(const sf::RenderWindow& window, Layer layer)
+{
+    if (!active || layer != this->layer || !frameDue()) return false;
+
+    const sf::Vector2u size = window.getSize();
+    if (static_cast<int>(size.x) != width || static_cast<int>(size.y) != height)
+    {
+        droppedFrames.fetch_add(1);
+        return false;
+    }
+
+    if (!readbackTried)
+    {
+        readbackTried = true;
+        readbackReady = createPackBuffers();
+    }
+
+    if (!readbackReady)
+    {
+        const int buffer = acquireBuffer(false);
+        if (buffer < 0) return false;
+
+        // Кадр еще в заднем буфере окна: чтение до display()
+        glReadPixels(0, 0, width, height, GL_RGBA, GL_UNSIGNED_BYTE, buffers[buffer].data());
+        submit(buffer, true);
+        return true;
+    }
+
+    // Копия в PBO идет на GPU, glReadPixels возвращается сразу
+    gl.bindBuffer(PIXEL_PACK_BUFFER, packBuffers[readbackSlot]);
+    glReadPixels(0, 0, width, height, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+    gl.bindBuffer(PIXEL_PACK_BUFFER, 0);
+    readbackFilled[readbackSlot] = true;
+
+    // Следующий слот хранит самый старый кадр - его и забираем
+    readbackSlot = (readbackSlot + 1) % READBACK_SLOTS;
+    if (readbackFilled[readbackSlot]) collectReadback(readbackSlot, false);
+    return true;
+}
+
+bool FrameCapture::createPackBuffers()
+{
+    if (!gl.load()) return false;
+
+    gl.genBuffers(READBACK_SLOTS, packBuffers);
+    const std::ptrdiff_t frameSize = static_cast<std::ptrdiff_t>(width) * height * 4;
+    for (int i = 0; i < READBACK_SLOTS; ++i)
+    {
+        gl.bindBuffer(PIXEL_PACK_BUFFER, packBuffers[i]);
+        gl.bufferData(PIXEL_PACK_BUFFER, frameSize, nullptr, STREAM_READ);
+    }
+    gl.bindBuffer(PIXEL_PACK_BUFFER, 0);
+    return true;
+}
+
+void FrameCapture::collectReadback(int slot, bool wait)
+{
+    readbackFilled[slot] = false;
+    const int buffer = acquireBuffer(wait);
+    if (buffer < 0) return; // кадр пропущен, слот свободен
+
+    gl.bindBuffer(PIXEL_PACK_BUFFER, packBuffers[slot]);
+    const void* pixels = gl.mapBuffer(PIXEL_PACK_BUFFER, READ_ONLY);
+    const bool mapped = pixels != nullptr;
+    if (mapped)
+    {
+        std::memcpy(buffers[buffer].data(), pixels, buffers[buffer].size());
+        gl.unmapBuffer(PIXEL_PACK_BUFFER);
+    }
+    gl.bindBuffer(PIXEL_PACK_BUFFER, 0);
+
+    if (mapped)
+    {
+        submit(buffer, true);
+        return;
+    }
+    droppedFrames.fetch_add(1);
+    std::lock_guard<std::mutex> lock(mutex);
+    freeBuffers.push_back(buffer);
+}
+
+void FrameCapture::releasePackBuffers()
+{
+    gl.deleteBuffers(READBACK_SLOTS, packBuffers);
+    std::fill(std::begin(packBuffers), std::end(packBuffers), 0u);
+}
+
+bool FrameCapture::capturePixels(const std::uint8_t* pixels, bool wait)
+{
+    if (!active || !frameDue()) return false;
+
+    const int buffer = acquireBuffer(wait);
+    if (buffer < 0) return false;
+
+    std::memcpy(buffers[buffer].data(), pixels, buffers[buffer].size());
+    submit(buffer, false);
+    return true;
+}
+
+bool FrameCapture::frameDue()
+{
+    if (frameInterval == std::chrono::steady_clock::duration::zero()) return true;
+
+    const std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+    if (now < nextFrameTime) return false;
+    nextFrameTime += frameInterval;
+    // Отстали больше чем на кадр (долгий кадр игры) - не догоняем пачкой
+    if (nextFrameTime <= now) nextFrameTime = now + frameInterval;
+    return true;
+}
+
+int FrameCapture::acquireBuffer(bool wait)
+{
+    std::unique_lock<std::mutex> lock(mutex);
+    if (wait) bufferFree.wait(lock, [this]() { return !freeBuffers.empty(); });
+    if (freeBuffers.empty())
+    {
+        // Диск не успевает: теряем кадр, а не время кадра
+        droppedFrames.fetch_add(1);
+        return -1;
+    }
+    const int buffer = freeBuffers.back();
+    freeBuffers.pop_back();
+    return buffer;
+}
+
+void FrameCapture::submit(int buffer, bool bottomUp)
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        Frame& frame = pending[(pendingHead + pendingCount) % bufferCount];
+        frame.buffer = buffer;
+        frame.index = queuedFrames++;
+        frame.bottomUp = bottomUp;
+        ++pendingCount;
+    }
+    wakeUp.notify_one();
+}
+
+void FrameCapture::writerLoop()
+{
+    AllocationTracker::Scope other(AllocationTracker::Subsystem::Other);
+    for (;;)
+    {
+        Frame frame;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            wakeUp.wait(lock, [this]() { return stopRequested || pendingCount > 0; });
+            if (pendingCount == 0) return; // остановка после записи всей очереди
+            frame = pending[pendingHead];
+            pendingHead = (pendingHead + 1) % bufferCount;
+            --pendingCount;
+        }
+
+        if (writeFrame(frame)) writtenFrames.fetch_add(1);
+        else droppedFrames.fetch_add(1);
+
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            freeBuffers.push_back(frame.buffer);
+        }
+        bufferFree.notify_one();
+    }
+}
+
+bool FrameCapture::writeFrame(const Frame& frame)
+{
+    std::vector<std::uint8_t>& pixels = buffers[frame.buffer];
+    const std::size_t rowSize = static_cast<std::size_t>(width) * 4;
+
+    if (format == Format::RAW_VIDEO)
+    {
+        if (!frame.bottomUp) return std::fwrite(pixels.data(), 1, pixels.size(), rawFile) == pixels.size();
+
+        // Переворот при записи: строки с конца буфера
+        for (int row = height - 1; row >= 0; --row)
+        {
+            if (std::fwrite(&pixels[row * rowSize], 1, rowSize, rawFile) != rowSize) return false;
+        }
+        return true;
+    }
+
+    if (frame.bottomUp)
+    {
+        for (int top = 0, bottom = height - 1; top < bottom; ++top, --bottom)
+        {
+            std::swap_ranges(pixels.begin() + top * rowSize, pixels.begin() + (top + 1) * rowSize,
+                pixels.begin() + bottom * rowSize);
+        }
+    }
+
+    char name[32];
+    std::snprintf(name, sizeof(name), "_%06d.png", frame.index);
+    sf::Image image;
+    image.create(static_cast<unsigned>(width), static_cast<unsigned>(height), pixels.data());
+    return image.saveToFile(prefix + name);
+}
@@ -0,0 +1,126 @@
+﻿/*
+Запись кадров игры без стороннего рекордера экрана.
+
+- Источник кадра - окно (чтение буфера кадра в точке отрисовки) или
+  готовый буфер RGBA, например SoftwareRenderer.
+- Окно читается асинхронно: glReadPixels в кольцо из READBACK_SLOTS
+  буферов GL_PIXEL_PACK_BUFFER (функции - через sf::Context::getFunction).
+  В буфер записи копируется кадр, снятый READBACK_SLOTS - 1 кадров назад:
+  GPU его уже отдал, и рендер не ждет конвейер. Без PBO (драйвер без
+  GL 1.5) - синхронный glReadPixels, он сбрасывает конвейер.
+- Точка снятия (Layer): WORLD - после мира, до счета и меню (чистые кадры
+  для роликов); WITH_UI - перед показом кадра, со всем интерфейсом
+  (для отчетов об ошибках).
+- Буферы кадров выделяются один раз в start() и ходят по кругу: поток
+  рендера берет свободный, заполняет и ставит в очередь; фоновый поток
+  кодирует кадр и возвращает буфер. Очередь ограничена числом буферов.
+- Частота записи - по настенным часам: кадр берется, только если с
+  предыдущего прошло не меньше 1/frameRate с, так что ролик идет с
+  реальной скоростью при любом FPS игры. frameRate 0 - каждый кадр
+  (офлайн-запись, где время задает симуляция).
+- Нет свободного буфера - кадр пропускается (droppedFrames), рендер не
+  ждет диск; офлайн-запись (capturePixels с wait) вместо этого ждет.
+- Формат: последовательность PNG (префикс_000000.png, ...) или один файл
+  сырого видео RGBA без заголовка (префикс.rgba) - он дешевле всего для
+  потока записи; stop() печатает размер и измеренную частоту записанных
+  кадров для ffmpeg.
+*/
+
+#pragma once
+#include <SFML/Graphics.hpp>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+class FrameCapture
+{
+public:
+    enum class Format { IMAGE_SEQUENCE, RAW_VIDEO };
+    enum class Layer { WORLD, WITH_UI };
+
+    explicit FrameCapture(int bufferCount = 8);
+    ~FrameCapture();
+    FrameCapture(const FrameCapture&) = delete;
+    FrameCapture& operator=(const FrameCapture&) = delete;
+
+    // Выделяет буферы и запускает поток записи; frameRate - кадров в
+    // секунду реального времени, 0 - все кадры. false - файл сырого видео
+    // не открылся.
+    bool start(const std::string& prefix, int width, int height, Format format, Layer layer, int frameRate = 0);
+
+    // Дописывает очередь, останавливает поток и печатает итог
+    void stop();
+
+    // Кадр окна, если запись идет из точки layer; false - не снят или пропущен
+    bool captureWindow(const sf::RenderWindow& window, Layer layer);
+
+    // Кадр RGBA сверху вниз размером width x height из start();
+    // wait - ждать свободный буфер вместо пропуска кадра
+    bool capturePixels(const std::uint8_t* pixels, bool wait);
+
+    bool isActive() const { return active; }
+    Layer getLayer() const { return layer; }
+    int getWrittenFrames() const { return writtenFrames.load(); }
+    int getDroppedFrames() const { return droppedFrames.load(); }
+
+private:
+    static const int READBACK_SLOTS = 3;
+
+    struct Frame
+    {
+        int buffer;
+        int index;     // номер записанного кадра (имя файла)
+        bool bottomUp; // строки снизу вверх, как отдает OpenGL
+    };
+
+    const int bufferCount;
+    std::vector<std::vector<std::uint8_t>> buffers;
+    std::vector<int> freeBuffers;
+    std::vector<Frame> pending; // кольцо на bufferCount кадров
+    int pendingHead = 0;
+    int pendingCount = 0;
+
+    std::string prefix;
+    int width = 0;
+    int height = 0;
+    Format format = Format::RAW_VIDEO;
+    Layer layer = Layer::WITH_UI;
+    std::chrono::steady_clock::duration frameInterval{}; // ноль - без ограничения частоты
+    std::chrono::steady_clock::time_point sessionStart;
+    std::chrono::steady_clock::time_point nextFrameTime;
+    int queuedFrames = 0;
+    bool active = false;
+    std::FILE* rawFile = nullptr;
+
+    // Кольцо PBO текущего сеанса; создается при первом кадре окна (нужен
+    // контекст GL), удаляется в stop()
+    unsigned int packBuffers[READBACK_SLOTS] = {}; // GLuint; 0 - нет
+    bool readbackFilled[READBACK_SLOTS] = {};
+    int readbackSlot = 0;     // слот для следующего glReadPixels
+    bool readbackTried = false;
+    bool readbackReady = false;
+
+    std::atomic<int> writtenFrames{ 0 };
+    std::atomic<int> droppedFrames{ 0 };
+
+    std::mutex mutex;
+    std::condition_variable wakeUp;     // появился кадр или остановка
+    std::condition_variable bufferFree; // поток записи вернул буфер
+    std::thread worker;
+    bool stopRequested = false;
+
+    bool frameDue();
+    bool createPackBuffers();
+    void collectReadback(int slot, bool wait);
+    void releasePackBuffers();
+    int acquireBuffer(bool wait);
+    void submit(int buffer, bool bottomUp);
+    void writerLoop();
+    bool writeFrame(const Frame& frame);
+};
@@ -22,7 +22,7 @@
 
 Основные функции:
 1. Инициализация:
-   - Загрузка ресурсов (шрифты, звуки, музыка)
+   - Асинхронная загрузка ресурсов (шрифты, звуки, музыка) с экраном загрузки
    - Настройка UI-элементов (меню, текст, оверлеи)
 2. Игровой процесс:
    - Спавн объектов (яблоки, препятствия, враги)
@@ -48,30 +48,33 @@
 - Поддержка паузы с сохранением оригинальных цветов объектов
 */
 
+#include <cstdio>
 #include <ctime>
 #include <stdexcept>
 #include <random>
 #include <algorithm>
+#include <type_traits>
 #include "Enemy.h"
 #include "Game.h"
 #include "CollisionSystem.h"
 
+namespace
+{
+    // Партии бота: бесконечные яблоки с ускорением доходят до поздних стадий игры
+    const int AUTOPILOT_MODE_MASK = UNLIMITED_APPLES | SPEED_UP;
+}
+
 Game::Game() : window(sf::VideoMode(Constants::SCREEN_WIDTH, Constants::SCREEN_HEIGHT), "Apples Game"),
-               uiHandler({ font, menuSound, menuSelectSound }),
+               renderTarget(window),
+               uiHandler({ font, menuSound, menuSelectSound, frameArena }),
                deathAnimationAlpha(255.0f), deathAnimationDuration(2.0f), isDeathAnimationActive(false)
 {
     std::srand(static_cast<unsigned>(std::time(nullptr)));
-    loadResources();
-    state = MAIN_MENU;
-
-    // Инициализация UI
-    uiHandler.initMainMenu();
-    uiHandler.initPauseMenu();
+    state = LOADING;
 
+    // Окно показывается сразу, ресурсы грузятся в фоне
     window.setVisible(true);
     window.requestFocus();
-    backgroundMusic.stop();
-    menuMusic.play();
 
     fadeOverlay.setSize(sf::Vector2f(Constants::SCREEN_WIDTH, Constants::SCREEN_HEIGHT));
     fadeOverlay.setFillColor(sf::Color(0, 0, 0, 0));
@@ -80,6 +83,14 @@ Game::Game() : window(sf::VideoMode(Constants::SCREEN_WIDTH, Constants::SCREEN_H
     initLeaderboardIfNeeded();
 
     appleGrid.init(Constants::SCREEN_WIDTH, Constants::SCREEN_HEIGHT, Constants::GRID_CELL_SIZE);
+    enemyGrid.init(Constants::SCREEN_WIDTH, Constants::SCREEN_HEIGHT, Constants::GRID_CELL_SIZE);
+    obstacleGrid.init(Constants::SCREEN_WIDTH, Constants::SCREEN_HEIGHT, Constants::GRID_CELL_SIZE);
+    staticLayer.init(Constants::SCREEN_WIDTH, Constants::SCREEN_HEIGHT);
+    flowField.init(Constants::SCREEN_WIDTH, Constants::SCREEN_HEIGHT, Constants::FLOW_FIELD_CELL_SIZE);
+    swarm.init(Constants::SCREEN_WIDTH, Constants::SCREEN_HEIGHT);
+    tickFunction = selectTick(gameModeMask);
+
+    loadResources();
 }
 
 void Game::handleMenuAction(UIHandler::MenuAction action) 
@@ -87,7 +98,8 @@ void Game::handleMenuAction(UIHandler::MenuAction action)
     switch (action) 
     {
     case UIHandler::MenuAction::START_GAME:
-        if (!isTransitioning) 
+        // Игра стартует только после загрузки игровых ресурсов
+        if (!isTransitioning && gameplayResourcesReady) 
         {
             menuSound.play();
             // Выбор режима игры
@@ -125,6 +137,40 @@ void Game::handlePauseAction(UIHandler::MenuAction action)
         break;
     default: break;
     }
+    setPauseTint(state == PAUSED);
+}
+
+// Серый цвет объектов на паузе: применяется при входе в паузу и снимается при выходе,
+// а не сохраняется и восстанавливается в каждом кадре
+void Game::setPauseTint(bool enabled)
+{
+    if (enabled == pauseTinted) return;
+    pauseTinted = enabled;
+
+    if (enabled)
+    {
+        pausedColors.clear();
+        pausedColors.push_back(player.sprite.getColor());
+        player.sprite.setColor(sf::Color(Constants::GRAY_COLOR_4));
+
+        for (auto& apple : apples)
+        {
+            pausedColors.push_back(apple.getColor());
+            apple.setColor(sf::Color(Constants::GRAY_COLOR));
+        }
+        for (auto& enemy : enemies)
+        {
+            pausedColors.push_back(enemy.getColor());
+            enemy.setColor(sf::Color(Constants::GRAY_COLOR_2));
+        }
+    }
+    else
+    {
+        size_t index = 0;
+        player.sprite.setColor(pausedColors[index++]);
+        for (auto& apple : apples) apple.setColor(pausedColors[index++]);
+        for (auto& enemy : enemies) enemy.setColor(pausedColors[index++]);
+    }
 }
 
 // Камера шейк
@@ -135,40 +181,62 @@ void Game::activateCameraShake()
     shakeIntensity = Constants::SHAKE_INTENSITY;
 }
 
+// Ставит ресурсы в очередь фоновой загрузки
 void Game::loadResources()
 {
-    if (!font.loadFromFile(Constants::RESOURCES_PATH + "Roboto-Regular.ttf"))
-        throw std::runtime_error("Failed to load font.");
-    // Загружает звуки
-    auto loadSound = [](sf::SoundBuffer& buffer, const std::string& path)
-        {
-            if (!buffer.loadFromFile(Constants::RESOURCES_PATH + path))
-                throw std::runtime_error("Failed to load sound: " + path);
-        };
+    using Group = ResourceLoader::Group;
 
-    loadSound(appleSoundBuffer, "apple.wav");
-    loadSound(bonusSoundBuffer, "bonus.wav");
-    loadSound(gameOverSoundBuffer, "game_over.wav");
-    loadSound(menuSoundBuffer, "menu.wav");
-    loadSound(menuSoundSelectBuffer, "menu_select.wav");
-    loadSound(winSoundBuffer, "win.wav");
+    // Пакет ресурсов необязателен: без него ресурсы читаются из Resources/
+    if (resourcePack.open(Constants::RESOURCE_PACK))
+    {
+        loader.setPack(&resourcePack);
+    }
 
-    // Инициализирует звуки
-    appleSound.setBuffer(appleSoundBuffer);
-    bonusSound.setBuffer(bonusSoundBuffer);
-    gameOverSound.setBuffer(gameOverSoundBuffer);
+    // Ресурсы главного меню
+    loader.addFont(Group::Menu, "Roboto-Regular.ttf", font);
+    loader.addSound(Group::Menu, "menu.wav", menuSoundBuffer);
+    loader.addSound(Group::Menu, "menu_select.wav", menuSoundSelectBuffer);
+    loader.addStream(Group::Menu, Constants::MENU_MUSIC);
+
+    // Игровые ресурсы
+    loader.addSound(Group::Gameplay, "apple.wav", appleSoundBuffer);
+    loader.addSound(Group::Gameplay, "bonus.wav", bonusSoundBuffer);
+    loader.addSound(Group::Gameplay, "game_over.wav", gameOverSoundBuffer);
+    loader.addSound(Group::Gameplay, "win.wav", winSoundBuffer);
+    loader.addTexture(Group::Gameplay, "player.png", playerTexture);
+    loader.addTexture(Group::Gameplay, "enemy.png", enemyTexture);
+    loader.addStream(Group::Gameplay, Constants::BACKGROUND_MUSIC);
+
+    loader.start();
+}
+
+// Забирает готовые ресурсы из загрузчика (главный поток)
+void Game::updateLoading()
+{
+    if (menuResourcesReady && gameplayResourcesReady) return;
+
+    loader.poll();
+
+    if (!menuResourcesReady && loader.isReady(ResourceLoader::Group::Menu))
+    {
+        menuResourcesReady = true;
+        onMenuResourcesLoaded();
+    }
+    if (!gameplayResourcesReady && loader.isReady(ResourceLoader::Group::Gameplay))
+    {
+        gameplayResourcesReady = true;
+        onGameplayResourcesLoaded();
+    }
+}
+
+void Game::onMenuResourcesLoaded()
+{
+    // Инициализирует звуки меню
     menuSound.setBuffer(menuSoundBuffer);
     menuSelectSound.setBuffer(menuSoundSelectBuffer);
-    winSound.setBuffer(winSoundBuffer);
 
-    // Загружает музыку
-    if (!backgroundMusic.openFromFile(Constants::RESOURCES_PATH + Constants::BACKGROUND_MUSIC))
-        throw std::runtime_error("Failed to load background music.");
-    backgroundMusic.setVolume(Constants::BACKGROUND_MUSIC_VOLUME);
-    backgroundMusic.setLoop(true);
-
-    if (!menuMusic.openFromFile(Constants::RESOURCES_PATH + Constants::MENU_MUSIC))
-        throw std::runtime_error("Failed to load main menu music!");
+    // Музыка читается потоково; CRC записи пакета проверен загрузчиком
+    openMusic(menuMusic, Constants::MENU_MUSIC, "Failed to load main menu music!");
     menuMusic.setLoop(true);
 
     // Инициализирует текст
@@ -194,6 +262,68 @@ void Game::loadResources()
     gameOverOverlay.setSize(sf::Vector2f(Constants::SCREEN_WIDTH, Constants::SCREEN_HEIGHT));
     gameOverOverlay.setFillColor(sf::Color(0, 0, 0, 0));
 
+    if (AllocationTracker::ENABLED)
+    {
+        allocationText.setFont(font);
+        allocationText.setCharacterSize(14);
+        allocationText.setFillColor(sf::Color::Yellow);
+        allocationText.setPosition(10, Constants::SCREEN_HEIGHT - 24);
+    }
+
+    // Инициализация UI
+    uiHandler.initMainMenu();
+    uiHandler.initPauseMenu();
+
+    state = MAIN_MENU;
+    menuMusic.play();
+}
+
+void Game::onGameplayResourcesLoaded()
+{
+    // Инициализирует звуки
+    appleSound.setBuffer(appleSoundBuffer);
+    bonusSound.setBuffer(bonusSoundBuffer);
+    gameOverSound.setBuffer(gameOverSoundBuffer);
+    winSound.setBuffer(winSoundBuffer);
+
+    // Загружает музыку
+    openMusic(backgroundMusic, Constants::BACKGROUND_MUSIC, "Failed to load background music.");
+    backgroundMusic.setVolume(Constants::BACKGROUND_MUSIC_VOLUME);
+    backgroundMusic.setLoop(true);
+
+    player.setTexture(playerTexture);
+}
+
+// Открывает музыку из пакета (поток читается прямо из отображения) или из файла;
+// запись уже проверена загрузчиком (addStream), find() не считает CRC повторно
+void Game::openMusic(sf::Music& music, const std::string& name, const std::string& error)
+{
+    const ResourcePack::Blob blob = resourcePack.find(name);
+    const bool opened = blob
+        ? music.openFromMemory(blob.data, blob.size)
+        : music.openFromFile(Constants::RESOURCES_PATH + name);
+    if (!opened)
+        throw std::runtime_error(error);
+}
+
+// Экран загрузки
+void Game::drawLoadingScreen()
+{
+    const sf::Vector2f barSize(Constants::SCREEN_WIDTH * 0.5f, 16.f);
+    const sf::Vector2f barPos((Constants::SCREEN_WIDTH - barSize.x) / 2.f, Constants::SCREEN_HEIGHT * 0.5f);
+
+    sf::RectangleShape frame(barSize);
+    frame.setPosition(barPos);
+    frame.setFillColor(sf::Color::Transparent);
+    frame.setOutlineColor(Constants::MENU_COLOR);
+    frame.setOutlineThickness(2.f);
+
+    sf::RectangleShape fill(sf::Vector2f(barSize.x * loader.getProgress(), barSize.y));
+    fill.setPosition(barPos);
+    fill.setFillColor(Constants::MENU_COLOR);
+
+    renderTarget.draw(frame);
+    renderTarget.draw(fill);
 }
 
 
@@ -201,16 +331,24 @@ void Game::loadResources()
 void Game::reset()
 {
     justStarted = true;
+
+    // Объекты переиспользуются из пулов: снимает с них серый цвет паузы
+    setPauseTint(false);
+
     player.reset();
     player.resetSpeed();
     spawnObstacles();
     spawnApples();
-    bonusApple.reset();
+    bonusApples.clear();
+    counters.bonusApples = 0;
     score = 0;
     lastBonusScore = 0;
     gameOverSoundPlayed = false;
     gameOverClock.restart();
     state = PLAYING;
+    tickFunction = selectTick(gameModeMask);
+    botGame = autopilotEnabled;
+    startLeaderboardEntry();
 
     // Установка позиции персонажа после спавна объектов
     player.position = 
@@ -225,8 +363,8 @@ void Game::reset()
         if (Collision::circleRectCollision(
             player,
             Constants::PLAYER_SIZE / 2,
-            *obs,
-            obs->getSize())) 
+            obs,
+            obs.getSize())) 
         {
             initialCollision = true;
             break;
@@ -298,16 +436,19 @@ void Game::spawnApples()
 
     for (int i = 0; i < numApples; ++i)
     {
-        auto apple = std::make_unique<Apple>();
+        // Яблоко из пула: без выделения памяти при перезапуске
+        Apple& apple = *apples.get(apples.acquire());
+        apple.active = true;
         do
         {
-            apple->position = randomPosition();
+            apple.position = randomPosition();
         } 
-        while (checkCollision(*apple));
-        apples.push_back(std::move(apple));
+        while (checkCollision(apple));
     }
     appleGrid.rebuild(apples);
+    counters.onApplesSpawned(static_cast<int>(apples.size()));
     appleCandidates.reserve(apples.size() / 3);
+    collisionEvents.reserve(apples.size() + Constants::NUM_OBSTACLES + Constants::NUM_ENEMIES + 2);
 }
 
 // Спавнит препятствия
@@ -318,7 +459,7 @@ void Game::spawnObstacles()
     for (int i = 0; i < Constants::NUM_OBSTACLES; ++i) 
     {
         bool collisionWithPlayer;
-        std::unique_ptr<Obstacle> obstacle;
+        Obstacle& obstacle = *obstacles.get(obstacles.acquire(Constants::MIN_OBSTACLE_SIZE, Constants::MIN_OBSTACLE_SIZE));
 
         do 
         {
@@ -331,13 +472,13 @@ void Game::spawnObstacles()
             float height = Constants::MIN_OBSTACLE_SIZE +
                 static_cast<float>(rand()) / (static_cast<float>(RAND_MAX / (Constants::MAX_OBSTACLE_SIZE - Constants::MIN_OBSTACLE_SIZE)));
 
-            // Создание препятствия
-            obstacle = std::make_unique<Obstacle>(width, height);
-            obstacle->position = randomPosition();
+            // Размещение препятствия (объект из пула)
+            obstacle.setSize({ width, height });
+            obstacle.position = randomPosition();
 
             // Явная проверка коллизии с игроком
             sf::FloatRect playerBounds = player.getBounds();
-            sf::FloatRect obstacleBounds = obstacle->getBounds();
+            sf::FloatRect obstacleBounds = obstacle.getBounds();
 
             if (playerBounds.intersects(obstacleBounds)) 
             {
@@ -346,26 +487,47 @@ void Game::spawnObstacles()
             }
 
         } 
-        while (checkCollision(*obstacle) || collisionWithPlayer);
-
-        obstacles.push_back(std::move(obstacle));
+        while (checkCollision(obstacle) || collisionWithPlayer);
     }
+
+    counters.obstacles = static_cast<int>(obstacles.size());
+
+    // Препятствия пересозданы: статический слой нужно перерисовать
+    staticLayer.invalidate();
+
+    // Поле потока обходит препятствия, расширенные на радиус противника
+    flowField.setObstacles(obstacles, Constants::PLAYER_SIZE * 0.6f);
+    obstacleGrid.rebuild(obstacles);
+    autopilot.setObstacles(obstacles);
 }
 
 // Спавнит противников
 void Game::spawnEnemies()
 {
     enemies.clear();
+    swarm.clear();
+
+    // В режиме SWARM стая заменяет обычных противников
+    if (HasGameMode(gameModeMask, GameMode::SWARM))
+    {
+        swarm.spawn(Constants::SWARM_SIZE, player.position, Constants::SWARM_SAFE_RADIUS);
+        counters.enemies = swarm.size();
+        enemyGrid.clear();
+        return;
+    }
+
     for (int i = 0; i < Constants::NUM_ENEMIES; ++i)
     {
-        auto enemy = std::make_unique<Enemy>();
+        Enemy& enemy = *enemies.get(enemies.acquire(enemyTexture));
+        enemy.respawn();
         do 
         {
-            enemy->position = randomPosition();
+            enemy.position = randomPosition();
         } 
-        while (checkCollision(*enemy));
-        enemies.push_back(std::move(enemy));
+        while (checkCollision(enemy));
     }
+    counters.enemies = static_cast<int>(enemies.size());
+    enemyGrid.rebuild(enemies);
 }
 
 // Случайная позиция на экране
@@ -392,14 +554,14 @@ bool Game::checkCollision(const GameObject& obj) const
 
     // Проверяет коллизию с яблоками
     for (const auto& apple : apples)
-        if (apple.get() != &obj && apple->active && Collision::circleCollide(obj, *apple, Constants::APPLE_SIZE / 2,
+        if (&apple != &obj && Collision::circleCollide(obj, apple, Constants::APPLE_SIZE / 2,
             Constants::APPLE_SIZE / 2))
             return true;
 
     // Проверяет коллизию с препятствиями
     for (const auto& obstacle : obstacles)
-        if (obstacle.get() != &obj && Collision::circleRectCollision(obj, Constants::APPLE_SIZE / 2,
-            *obstacle, obstacle->getSize()))
+        if (&obstacle != &obj && Collision::circleRectCollision(obj, Constants::APPLE_SIZE / 2,
+            obstacle, obstacle.getSize()))
             return true;
 
     return false;
@@ -418,76 +580,194 @@ void Game::checkBoundaries()
     // Проверяет с запасом в 1 пиксель
     if (left < 1.0f || right > Constants::SCREEN_WIDTH - 1.0f || top < 1.0f || bottom > Constants::SCREEN_HEIGHT - 1.0f)
     {
-        triggerGameOver(CollisionType::Boundary);
-        activateCameraShake();
+        collisionEvents.push_back({ CollisionType::Boundary, SlotHandle(), 1.0f });
     }
 }
 
-// Проверяет коллизию с препятствиями
+// Проверяет коллизию с препятствиями вдоль всего шага игрока
 void Game::checkObstaclesCollision()
 {
-    for (const auto& obstacle : obstacles)
+    for (std::size_t i = 0; i < obstacles.size(); ++i)
     {
-        if (Collision::circleRectCollision(player, Constants::PLAYER_SIZE / 2, *obstacle, obstacle->getSize()))
+        float timeOfImpact = 0.0f;
+        if (Collision::sweptCircleRect(player.previousPosition, player.position, Constants::PLAYER_SIZE / 2,
+            obstacles[i].position, obstacles[i].getSize(), timeOfImpact))
         {
-            triggerGameOver(CollisionType::Obstacle);
-            activateCameraShake();
+            collisionEvents.push_back({ CollisionType::Obstacle, obstacles.handleAt(i), timeOfImpact });
         }
     }
 }
 
+// Проверяет коллизию с противниками (относительное движение за шаг)
+void Game::checkEnemiesCollision()
+{
+    for (std::size_t i = 0; i < enemies.size(); ++i)
+    {
+        const Enemy& enemy = enemies[i];
+        float timeOfImpact = 0.0f;
+        if (Collision::sweptCircleCircle(player.previousPosition - enemy.previousPosition,
+            player.position - enemy.position, Constants::PLAYER_SIZE / 2,
+            sf::Vector2f(), Constants::PLAYER_SIZE / 2, timeOfImpact))
+        {
+            collisionEvents.push_back({ CollisionType::Enemy, enemies.handleAt(i), timeOfImpact });
+        }
+    }
+}
+
+// Проверяет коллизию со стаей: одно событие по самой ранней особи
+void Game::checkSwarmCollision()
+{
+    float timeOfImpact = 0.0f;
+    if (swarm.hitsCircle(player.previousPosition, player.position, Constants::PLAYER_SIZE / 2, timeOfImpact))
+    {
+        collisionEvents.push_back({ CollisionType::Enemy, SlotHandle(), timeOfImpact });
+    }
+}
+
 // Проверяет коллизию с яблоками
 void Game::checkAppleCollision()
 {
-    // Сбор кандидатов из 3×3 ячеек вокруг игрока
-    appleGrid.collectNear(player.position, appleCandidates);
+    // Сбор кандидатов из ячеек вдоль шага игрока
+    appleGrid.collectAlong(player.previousPosition, player.position, appleCandidates);
 
-    for (int idx : appleCandidates)
+    for (SlotHandle handle : appleCandidates)
     {
-        if (idx < 0 || idx >= static_cast<int>(apples.size())) continue;
-        auto& apple = apples[idx];
-        if (!apple->active) continue;
+        const Apple* apple = apples.get(handle);
+        if (!apple) continue;
 
-        if (Collision::circleCollide(player, *apple,
-            Constants::PLAYER_SIZE / 2,
-            Constants::APPLE_SIZE / 2))
+        float timeOfImpact = 0.0f;
+        if (Collision::sweptCircleCircle(player.previousPosition, player.position,
+            Constants::PLAYER_SIZE / 2, apple->position,
+            Constants::APPLE_SIZE / 2, timeOfImpact))
         {
-            score++;
-            appleSound.play();
-            if (HasGameMode(gameModeMask, GameMode::SPEED_UP))
-                player.increaseSpeed();
+            collisionEvents.push_back({ CollisionType::Apple, handle, timeOfImpact });
+        }
+    }
+}
 
-            player.isBlinking = true;
-            player.blinkClock.restart();
+// Применяет съедание яблока
+template <typename Mode>
+void Game::collectApple(SlotHandle handle)
+{
+    Apple* apple = apples.get(handle);
+    if (!apple) return;
 
-            // обновляет сетки только точечно
-            if (HasGameMode(gameModeMask, GameMode::UNLIMITED_APPLES))
-            {
-                // респавнит в новой позиции
-                const sf::Vector2f oldPos = apple->position;
+    score++;
+    if (Mode::speedUp)
+        player.increaseSpeed();
 
-                do 
-                {
-                    apple->position = randomPosition();
-                } 
-                while (checkCollision(*apple));
+    // обновляет сетки только точечно
+    if (Mode::unlimitedApples)
+    {
+        // респавнит в новой позиции
+        const sf::Vector2f oldPos = apple->position;
 
-                // перемещает индекс apple в сетке без rebuild
-                appleGrid.move(idx, oldPos, apple->position);
-            }
-            else
+        do 
+        {
+            apple->position = randomPosition();
+        } 
+        while (checkCollision(*apple));
+
+        // перемещает дескриптор apple в сетке без rebuild
+        appleGrid.move(handle, oldPos, apple->position);
+    }
+    else
+    {
+        // LIMITED: удаляет яблоко (swap-remove) и его дескриптор из сетки
+        appleGrid.erase(handle, apple->position);
+        apples.erase(handle);
+    }
+    counters.onAppleEaten(Mode::unlimitedApples);
+}
+
+// Применяет съедание бонусного яблока
+void Game::collectBonusApple()
+{
+    score += Constants::BONUS_SCORE_VALUE;
+    player.speed *= Constants::SPEED_REDUCTION_FACTOR;
+    bonusApples.erase(bonusAppleHandle);
+    counters.bonusApples = 0;
+}
+
+// Разбирает события тика: сортирует по времени контакта, убирает повторы
+// и применяет реакцию один раз
+template <typename Mode>
+void Game::resolveCollisions()
+{
+    if (collisionEvents.empty()) return;
+
+    auto byObject = [](const CollisionEvent& a, const CollisionEvent& b)
+    {
+        if (a.type != b.type) return a.type < b.type;
+        if (a.target != b.target) return a.target < b.target;
+        return a.timeOfImpact < b.timeOfImpact;
+    };
+    auto sameObject = [](const CollisionEvent& a, const CollisionEvent& b)
+    {
+        return a.type == b.type && a.target == b.target;
+    };
+    auto byTime = [](const CollisionEvent& a, const CollisionEvent& b)
+    {
+        if (a.timeOfImpact != b.timeOfImpact) return a.timeOfImpact < b.timeOfImpact;
+        if (a.type != b.type) return a.type < b.type;
+        return a.target < b.target;
+    };
+
+    // Одно событие на объект (самое раннее), затем порядок по времени
+    std::sort(collisionEvents.begin(), collisionEvents.end(), byObject);
+    collisionEvents.erase(std::unique(collisionEvents.begin(), collisionEvents.end(), sameObject),
+        collisionEvents.end());
+    std::sort(collisionEvents.begin(), collisionEvents.end(), byTime);
+
+    bool appleCollected = false;
+    bool bonusCollected = false;
+
+    for (const auto& event : collisionEvents)
+    {
+        if (event.type == CollisionType::Apple)
+        {
+            collectApple<Mode>(event.target);
+            appleCollected = true;
+        }
+        else if (event.type == CollisionType::BonusApple)
+        {
+            if (bonusApples.contains(event.target)) collectBonusApple();
+            bonusCollected = true;
+        }
+        else
+        {
+            // Первое смертельное столкновение завершает тик: более поздние события не применяются
+            if (event.type == CollisionType::Obstacle)
             {
-                // LIMITED: деактивирует яблоко и удаляет его индекс из сетки
-                appleGrid.erase(idx, apple->position);
-                apple->active = false;
+                // Останавливает игрока в точке контакта, а не за препятствием
+                player.position = player.previousPosition
+                    + (player.position - player.previousPosition) * event.timeOfImpact;
             }
+            triggerGameOver(event.type);
+            break;
         }
     }
+
+    if (appleCollected)
+    {
+        appleSound.play();
+        player.isBlinking = true;
+        player.blinkClock.restart();
+    }
+    if (bonusCollected) bonusSound.play();
+
+    collisionEvents.clear();
 }
 
-// Обрабатывает инпут с клавиатуры
+// Обрабатывает инпут с клавиатуры (или решение бота)
 void Game::handlePlayerInput()
 {
+    if (autopilotEnabled)
+    {
+        player.direction = autopilot.decide(player, spatialQuery, enemies);
+        return;
+    }
+
     if (sf::Keyboard::isKeyPressed(sf::Keyboard::Right))
         player.direction = Direction::Right;
     else if (sf::Keyboard::isKeyPressed(sf::Keyboard::Up))
@@ -499,45 +779,154 @@ void Game::handlePlayerInput()
 }
 
 // Взаимодействие с бонусным яблоком
+template <typename Mode>
 void Game::updateBonusApple()
 {
-    if (!HasGameMode(gameModeMask, GameMode::SPEED_UP))
+    if (!Mode::speedUp)
         return;
 
-    if (score - lastBonusScore >= Constants::BONUS_SCORE_INTERVAL && !bonusApple)
+    if (score - lastBonusScore >= Constants::BONUS_SCORE_INTERVAL && bonusApples.empty())
     {
-        bonusApple = std::make_unique<BonusApple>();
+        bonusAppleHandle = bonusApples.acquire();
+        BonusApple& spawned = *bonusApples.get(bonusAppleHandle);
+        spawned.respawn();
         do
         {
-            bonusApple->position = randomPosition();
+            spawned.position = randomPosition();
         } 
-        while (checkCollision(*bonusApple));
+        while (checkCollision(spawned));
         lastBonusScore = score;
+        counters.bonusApples = 1;
     }
 
-    if (bonusApple)
+    float bonusImpact = 0.0f;
+    if (BonusApple* bonusApple = bonusApples.get(bonusAppleHandle))
     {
         bonusApple->update();
         if (bonusApple->isExpired())
         {
-            bonusApple.reset();
+            bonusApples.erase(bonusAppleHandle);
+            counters.bonusApples = 0;
         }
-        else if (Collision::circleCollide(player, *bonusApple, Constants::PLAYER_SIZE / 2, Constants::APPLE_SIZE / 2))
+        else if (Collision::sweptCircleCircle(player.previousPosition, player.position, Constants::PLAYER_SIZE / 2,
+            bonusApple->position, Constants::APPLE_SIZE / 2, bonusImpact))
         {
-            score += Constants::BONUS_SCORE_VALUE;
-            player.speed *= Constants::SPEED_REDUCTION_FACTOR;
-            bonusSound.play();
-            bonusApple.reset();
+            collisionEvents.push_back({ CollisionType::BonusApple, bonusAppleHandle, bonusImpact });
         }
     }
 }
 
+// Выбирает специализацию тика по маске режимов (один раз за сессию)
+// Флаги режима переводятся в параметры GameModePolicy по одному, слева
+// направо: новый флаг режима - еще один элемент flags в selectTick(), без
+// ручной таблицы указателей
+template <bool... Chosen>
+struct Game::TickSelector
+{
+    static TickFunction select(const bool* flags)
+    {
+        return pick(flags, std::integral_constant<bool, sizeof...(Chosen) == MODE_FLAG_COUNT>());
+    }
+
+private:
+    static TickFunction pick(const bool*, std::true_type)
+    {
+        return &Game::tick<GameModePolicy<Chosen...>>;
+    }
+
+    static TickFunction pick(const bool* flags, std::false_type)
+    {
+        return *flags ? TickSelector<Chosen..., true>::select(flags + 1)
+            : TickSelector<Chosen..., false>::select(flags + 1);
+    }
+};
+
+// LIMITED_APPLES имеет приоритет, как и в spawnApples(): флаг UNLIMITED_APPLES
+// после него не учитывается (и сочетание обоих не инстанцируется)
+template <>
+struct Game::TickSelector<true>
+{
+    static TickFunction select(const bool* flags)
+    {
+        return TickSelector<true, false>::select(flags + 1);
+    }
+};
+
+Game::TickFunction Game::selectTick(int modeMask)
+{
+    const bool flags[MODE_FLAG_COUNT] =
+    {
+        HasGameMode(modeMask, GameMode::LIMITED_APPLES),
+        HasGameMode(modeMask, GameMode::UNLIMITED_APPLES),
+        HasGameMode(modeMask, GameMode::SPEED_UP),
+        HasGameMode(modeMask, GameMode::CHASE),
+        HasGameMode(modeMask, GameMode::SWARM),
+    };
+    return TickSelector<>::select(flags);
+}
+
+// Игровой тик в состоянии PLAYING
+template <typename Mode>
+void Game::tick(float deltaTime)
+{
+    handlePlayerInput();
+    player.update();
+
+    // Скорости противников задаются до общего перемещения (только в режиме PLAYING)
+    if (Mode::chase && !Mode::swarm)
+    {
+        // Поле пересчитывается, только когда игрок перешел в другую клетку
+        flowField.update(player.position);
+        for (auto& enemy : enemies) enemy.chase(flowField);
+    }
+    else if (!Mode::swarm)
+    {
+        for (auto& enemy : enemies) enemy.wander();
+    }
+
+    // Игрок и противники перемещаются по скоростям за один проход
+    movement.step(deltaTime, player, enemies);
+
+    checkBoundaries();
+    checkObstaclesCollision();
+    checkAppleCollision();
+    updateBonusApple<Mode>();
+
+    if (Mode::swarm)
+    {
+        if (Mode::chase) flowField.update(player.position);
+        swarm.update(deltaTime, Mode::chase ? &flowField : nullptr);
+        swarm.collideObstacles(obstacles, obstacleGrid);
+    }
+    else if (Mode::chase)
+    {
+        for (auto& enemy : enemies) enemy.clampToScreen();
+    }
+    else
+    {
+        for (auto& enemy : enemies) enemy.resolveMove(obstacles);
+    }
+    if (!Mode::swarm) enemyGrid.rebuild(enemies);
+    checkEnemiesCollision();
+    if (Mode::swarm) checkSwarmCollision();
+
+    // Реакция на все столкновения тика
+    resolveCollisions<Mode>();
+
+    // Победа в режиме с ограниченными яблоками
+    if (Mode::limitedApples && state == PLAYING && counters.allApplesCollected())
+    {
+        triggerWin();
+    }
+}
+
 // Триггер Win
 void Game::triggerWin()
 {
     backgroundMusic.stop();
     winSoundPlayed = false;
     state = WIN;
+    commitPlayerScore();
     winTimer.restart(); // Сбрасывает таймер экрана победы
 }
 
@@ -547,6 +936,8 @@ void Game::triggerGameOver(CollisionType type)
     if (state != GAME_OVER && !isBlinking)
     {
         state = GAME_OVER;
+        gameOverCause = type;
+        commitPlayerScore();
         gameOverFadeAlpha = 0.0f;
         isFadingObjects = true;
         gameObjectsFadeAlpha = 255.0f;
@@ -572,6 +963,8 @@ void Game::triggerGameOver(CollisionType type)
             case CollisionType::Enemy:
                 blinkColor = Constants::ENEMY_BLINK_COLOR;
                 break;
+            default:
+                break;
         }
         blinkColor.a = 0;
         activateCameraShake();
@@ -587,12 +980,13 @@ void Game::drawGameOverScreen()
     float alpha = (sin(gameOverBlinkClock.getElapsedTime().asSeconds() * Constants::GAME_OVER_BLINK_SPEED) + 1) * 127.5f;
     gameOverText.setOutlineColor(sf::Color(255, 0, 0, static_cast<sf::Uint8>(alpha)));
 
-    gameOverText.setString("GAME OVER!\nFinal Score: " + std::to_string(score));
+    UIHandler::setTextIfChanged(gameOverText, shownGameOverText,
+        frameArena.format("GAME OVER!\nFinal Score: %d", score));
     sf::FloatRect textBounds = gameOverText.getLocalBounds();
     gameOverText.setOrigin(textBounds.width/2, textBounds.height/2);
     const float titleY = Constants::SCREEN_HEIGHT * Constants::OVERLAY_TITLE_Y_RATIO;
     gameOverText.setPosition(Constants::SCREEN_WIDTH / 2, titleY);
-    window.draw(gameOverText);
+    renderTarget.draw(gameOverText);
 }
 
 // Экран Win
@@ -602,26 +996,256 @@ void Game::drawWinScreen()
     float alpha = (sin(gameOverBlinkClock.getElapsedTime().asSeconds() * Constants::GAME_OVER_BLINK_SPEED) + 1) * 127.5f;
     gameOverText.setOutlineColor(sf::Color(0, 255, 0, static_cast<sf::Uint8>(alpha))); 
 
-    gameOverText.setString("YOU WIN!\nFinal Score: " + std::to_string(score));
+    UIHandler::setTextIfChanged(gameOverText, shownGameOverText,
+        frameArena.format("YOU WIN!\nFinal Score: %d", score));
     sf::FloatRect textBounds = gameOverText.getLocalBounds();
     gameOverText.setOrigin(textBounds.width / 2, textBounds.height / 2);
     const float titleY = Constants::SCREEN_HEIGHT * Constants::OVERLAY_TITLE_Y_RATIO;
     gameOverText.setPosition(Constants::SCREEN_WIDTH / 2, titleY);
-    window.draw(gameOverText);
+    renderTarget.draw(gameOverText);
 }
 
 // Главный игровой цикл
 void Game::run()
 {
-    menuMusic.play();
     sf::Clock frameClock;
     while (window.isOpen())
     {
         sf::Time deltaTime = frameClock.restart();
-        handleEvents();
-        update(deltaTime.asSeconds());
+        runFrame(deltaTime.asSeconds(), true);
+    }
+}
+
+AllocationTracker::FrameStats Game::runFrame(float deltaTime, bool handleInput)
+{
+    using AllocationTracker::Subsystem;
+
+    AllocationTracker::beginFrame();
+    sf::Clock stageClock;
+    {
+        AllocationTracker::Scope sim(Subsystem::Sim);
+        if (handleInput) handleEvents();
+        else drainEvents();
+        update(deltaTime);
+    }
+    const sf::Time updateTime = stageClock.restart();
+    {
+        AllocationTracker::Scope ui(Subsystem::UI);
         render();
     }
+    const sf::Time renderTime = stageClock.getElapsedTime();
+    const AllocationTracker::FrameStats stats = AllocationTracker::endFrame();
+
+    DebugOverlay::FrameSample sample;
+    sample.frameMs = deltaTime * 1000.0f;
+    sample.updateMs = updateTime.asSeconds() * 1000.0f;
+    sample.renderMs = renderTime.asSeconds() * 1000.0f;
+    sample.drawCalls = renderTarget.getLastFrame().drawCalls;
+    sample.vertices = renderTarget.getLastFrame().vertices;
+    sample.textureSwitches = renderTarget.getLastFrame().textureSwitches;
+    debugOverlay.addFrame(sample);
+
+    lastAllocations = stats;
+    reportAllocations(stats);
+    return stats;
+}
+
+// Очередь событий окна без обработки ввода (только закрытие)
+void Game::drainEvents()
+{
+    AllocationTracker::Scope other(AllocationTracker::Subsystem::Other);
+    sf::Event event;
+    while (window.pollEvent(event))
+    {
+        if (event.type == sf::Event::Closed) window.close();
+    }
+}
+
+// Оверлей и журнал выделений; в журнал попадают только кадры игры, паузы
+// и Game Over, выделившие память в Sim или UI
+void Game::reportAllocations(const AllocationTracker::FrameStats& stats)
+{
+    if (!AllocationTracker::ENABLED) return;
+
+    using AllocationTracker::Subsystem;
+    AllocationTracker::Scope other(Subsystem::Other);
+
+    const AllocationTracker::SubsystemStats& sim = stats[Subsystem::Sim];
+    const AllocationTracker::SubsystemStats& ui = stats[Subsystem::UI];
+    const AllocationTracker::SubsystemStats& audio = stats[Subsystem::Audio];
+
+    char line[160];
+    std::snprintf(line, sizeof(line), "alloc/frame sim %zu ui %zu audio %zu | heap %zu KB, peak %zu KB",
+        sim.allocations, ui.allocations, audio.allocations,
+        stats.liveBytes / 1024, AllocationTracker::getPeakBytes() / 1024);
+    UIHandler::setTextIfChanged(allocationText, shownAllocationText, line);
+
+    const bool steadyState = state == PLAYING || state == PAUSED || state == GAME_OVER;
+    if (steadyState && sim.allocations + ui.allocations > 0)
+    {
+        const char* stateName = state == PLAYING ? "PLAYING" : state == PAUSED ? "PAUSED" : "GAME_OVER";
+        std::fprintf(stderr, "[alloc] %s: sim %zu (%zu B), ui %zu (%zu B), audio %zu (%zu B), frame peak %zu KB\n",
+            stateName, sim.allocations, sim.bytes, ui.allocations, ui.bytes,
+            audio.allocations, audio.bytes, stats.peakBytes / 1024);
+    }
+}
+
+bool Game::runAllocationCheck(int ticks)
+{
+    if (!AllocationTracker::ENABLED)
+    {
+        std::fprintf(stderr, "Allocation check requires a build with APPLES_ALLOC_TRACKING\n");
+        return false;
+    }
+
+    // Кадры с фиксированным шагом до загрузки всех ресурсов
+    const float deltaTime = 1.0f / 60.0f;
+    while (window.isOpen() && !(menuResourcesReady && gameplayResourcesReady))
+    {
+        runFrame(deltaTime, false);
+    }
+
+    bool passed = checkAllocationPhase(PLAYING, "PLAYING", ticks);
+    passed = checkAllocationPhase(PAUSED, "PAUSED", ticks) && passed;
+    passed = checkAllocationPhase(GAME_OVER, "GAME_OVER", ticks) && passed;
+
+    std::printf("Allocation check %s, heap peak %zu KB\n",
+        passed ? "passed" : "FAILED", AllocationTracker::getPeakBytes() / 1024);
+    return passed;
+}
+
+void Game::enableAttractMode()
+{
+    attractMode = true;
+    autopilotEnabled = true;
+}
+
+void Game::runSoak(int ticks)
+{
+    // Прогон без звука: музыка и эффекты не нужны и не должны играть на стенде
+    sf::Listener::setGlobalVolume(0.0f);
+
+    const float deltaTime = 1.0f / 60.0f;
+    while (window.isOpen() && !(menuResourcesReady && gameplayResourcesReady))
+    {
+        runFrame(deltaTime, false);
+    }
+
+    autopilotEnabled = true;
+    gameModeMask = AUTOPILOT_MODE_MASK;
+    reset();
+
+    int games = 1;
+    int wins = 0;
+    int deaths[3] = {}; // препятствие, край, противник
+    int bestScore = 0;
+    long long totalScore = 0;
+    float maxSpeed = 0.0f;
+    float worstTickMs = 0.0f;
+    double totalTickMs = 0.0;
+    sf::Clock tickClock;
+
+    int tick = 0;
+    for (; tick < ticks && window.isOpen(); ++tick)
+    {
+        drainEvents();
+        tickClock.restart();
+        update(deltaTime);
+        const float tickMs = tickClock.getElapsedTime().asSeconds() * 1000.0f;
+        totalTickMs += tickMs;
+        worstTickMs = std::max(worstTickMs, tickMs);
+        maxSpeed = std::max(maxSpeed, player.getSpeed());
+        bestScore = std::max(bestScore, score);
+
+        // Без экранов Game Over / победы: следующая партия начинается сразу
+        if (state == GAME_OVER || state == WIN || state == MAIN_MENU)
+        {
+            if (state == GAME_OVER)
+            {
+                const int cause = gameOverCause == CollisionType::Obstacle ? 0
+                    : gameOverCause == CollisionType::Boundary ? 1 : 2;
+                ++deaths[cause];
+            }
+            else
+            {
+                ++wins;
+            }
+            totalScore += score;
+            reset();
+            ++games;
+        }
+    }
+    totalScore += score;
+
+    std::printf("Soak: %d ticks (%.1f s of play), %d games, %d wins\n",
+        tick, tick * deltaTime, games, wins);
+    std::printf("Deaths: obstacle %d, boundary %d, enemy %d\n", deaths[0], deaths[1], deaths[2]);
+    std::printf("Score: best %d, average %.1f; max speed %.0f\n",
+        bestScore, static_cast<double>(totalScore) / games, maxSpeed);
+    std::printf("Tick: average %.3f ms, worst %.3f ms\n", tick > 0 ? totalTickMs / tick : 0.0, worstTickMs);
+}
+
+// Переводит игру в проверяемое состояние тем же путем, что и игрок
+void Game::enterAllocationCheckPhase(GameState phase)
+{
+    reset();
+    if (phase == PAUSED) togglePause();
+    else if (phase == GAME_OVER) triggerGameOver(CollisionType::Boundary);
+}
+
+// Устоявшийся кадр: после прогрева, и состояние не менялось за кадр. Смерть игрока
+// или автоматический рестарт после Game Over возвращают в фазу заново с прогревом
+bool Game::checkAllocationPhase(GameState phase, const char* name, int ticks)
+{
+    using AllocationTracker::Subsystem;
+
+    const float deltaTime = 1.0f / 60.0f;
+    const int warmupFrames = 30;
+    const int maxFrames = ticks * 20 + warmupFrames;
+    const int maxReports = 5;
+
+    int steadyFrames = 0;
+    int allocatingFrames = 0;
+    int warmup = 0;
+    std::size_t peakBytes = 0;
+
+    for (int frame = 0; steadyFrames < ticks; ++frame)
+    {
+        if (!window.isOpen() || frame >= maxFrames)
+        {
+            std::printf("%s: only %d of %d steady frames reached\n", name, steadyFrames, ticks);
+            return false;
+        }
+
+        if (state != phase)
+        {
+            enterAllocationCheckPhase(phase);
+            warmup = warmupFrames;
+        }
+
+        const bool steady = warmup == 0;
+        if (warmup > 0) --warmup;
+
+        const AllocationTracker::FrameStats stats = runFrame(deltaTime, false);
+        if (!steady || state != phase) continue;
+
+        ++steadyFrames;
+        peakBytes = std::max(peakBytes, stats.peakBytes);
+
+        const std::size_t allocations = stats[Subsystem::Sim].allocations + stats[Subsystem::UI].allocations;
+        if (allocations > 0)
+        {
+            if (++allocatingFrames <= maxReports)
+            {
+                std::printf("%s: frame %d allocated (sim %zu, ui %zu)\n", name, steadyFrames,
+                    stats[Subsystem::Sim].allocations, stats[Subsystem::UI].allocations);
+            }
+        }
+    }
+
+    std::printf("%s: %d frames, %d allocating, frame heap peak %zu KB\n",
+        name, steadyFrames, allocatingFrames, peakBytes / 1024);
+    return allocatingFrames == 0;
 }
 
 // Обрабочик игровых эвентов
@@ -632,6 +1256,46 @@ void Game::handleEvents()
     {
         if (event.type == sf::Event::Closed) window.close();
 
+        if (event.type == sf::Event::KeyPressed && event.key.code == sf::Keyboard::F3)
+        {
+            debugOverlay.toggle();
+            continue;
+        }
+        if (event.type == sf::Event::KeyPressed && event.key.code == sf::Keyboard::F4)
+        {
+            renderStatsDumpRequested = true; // печать статистики отрисовки следующего кадра
+            continue;
+        }
+        if (event.type == sf::Event::KeyPressed && event.key.code == sf::Keyboard::F5)
+        {
+            rasterizeGame(occupancy, player, apples, obstacles, enemies, bonusApples, swarm);
+            if (occupancy.writePgm(Constants::OCCUPANCY_DUMP))
+                std::printf("Occupancy raster written to %s\n", Constants::OCCUPANCY_DUMP.c_str());
+            continue;
+        }
+        if (event.type == sf::Event::KeyPressed
+            && (event.key.code == sf::Keyboard::F6 || event.key.code == sf::Keyboard::F7))
+        {
+            toggleCapture(event.key.code == sf::Keyboard::F6 ? FrameCapture::Layer::WITH_UI : FrameCapture::Layer::WORLD);
+            continue;
+        }
+        if (event.type == sf::Event::KeyPressed && event.key.code == sf::Keyboard::F2)
+        {
+            autopilotEnabled = !autopilotEnabled;
+            if (autopilotEnabled) botGame = true; // партия с помощью бота тоже не засчитывается
+            continue;
+        }
+
+        // Любая клавиша в attract-режиме возвращает управление игроку
+        if (attractMode && event.type == sf::Event::KeyPressed)
+        {
+            attractMode = false;
+            autopilotEnabled = false;
+        }
+
+        // До загрузки меню ввод не обрабатывается
+        if (state == LOADING) continue;
+
         if (state == LEADERBOARD)
         {
             if (event.type == sf::Event::KeyPressed)
@@ -660,39 +1324,67 @@ void Game::handleEvents()
         {
             if (event.type == sf::Event::KeyPressed && event.key.code == sf::Keyboard::P) 
             {
-                if (state != GAME_OVER) 
-                {
-                    bool wasPaused = (state == PAUSED);
-                    state = (state == PAUSED) ? PLAYING : PAUSED;
-
-                    // Приостанавливает / возобновляем таймеры противников
-                    for (auto& enemy : enemies)
-                    {
-                        if (wasPaused) enemy->resumeTimers();
-                        else enemy->pauseTimers();
-                    }
-
-                    menuSound.play();
-                    if (state == PAUSED) 
-                    {
-                        uiHandler.resetPauseMenu();
-                        backgroundMusic.pause();
-                    }
-                    else 
-                    {
-                        backgroundMusic.setVolume(Constants::BACKGROUND_MUSIC_VOLUME);
-                        backgroundMusic.play();
-                    }
-                }
+                togglePause();
             }
         }
     }
 }
 
+// Пауза по клавише P
+void Game::togglePause()
+{
+    if (state == GAME_OVER) return;
+
+    bool wasPaused = (state == PAUSED);
+    state = (state == PAUSED) ? PLAYING : PAUSED;
+
+    // Приостанавливает / возобновляем таймеры противников
+    for (auto& enemy : enemies)
+    {
+        if (wasPaused) enemy.resumeTimers();
+        else enemy.pauseTimers();
+    }
+
+    setPauseTint(state == PAUSED);
+
+    menuSound.play();
+    if (state == PAUSED) 
+    {
+        uiHandler.resetPauseMenu();
+        backgroundMusic.pause();
+    }
+    else 
+    {
+        backgroundMusic.setVolume(Constants::BACKGROUND_MUSIC_VOLUME);
+        backgroundMusic.play();
+    }
+}
+
 void Game::initLeaderboardIfNeeded()
 {
     if (leaderboardInitialized) return;
 
+    // История результатов с диска (уже отсортирована по убыванию)
+    for (const auto& record : leaderboardStore.load())
+    {
+        leaderboardIndex.insert(record.name, record.score);
+    }
+
+    if (leaderboardIndex.size() == 0)
+    {
+        seedLeaderboardWithBots();
+    }
+
+    // Добавляет строку игрока начинается с 0 очков
+    playerEntryId = leaderboardIndex.insert("Player", 0);
+    leaderboardDirty = true;
+
+    leaderboardInitialized = true;
+}
+
+// Первый запуск: таблица заполняется ботами, они сохраняются вместе с историей
+void Game::seedLeaderboardWithBots()
+{
     // Имена ботов
     static const std::vector<std::string> kNames = 
     {
@@ -711,79 +1403,99 @@ void Game::initLeaderboardIfNeeded()
     std::shuffle(pool.begin(), pool.end(), rng);
     pool.resize(std::min<int>(botCount, (int)pool.size()));
 
-    leaderboard.clear();
-    leaderboard.reserve(botCount + 1);
-
     for (const auto& nm : pool) 
     {
-        leaderboard.push_back({ nm, distScore(rng), false });
+        const int botScore = distScore(rng);
+        leaderboardIndex.insert(nm, botScore);
+        leaderboardStore.append(nm, botScore);
     }
-
-    // Добавляет строку игрока начинается с 0 очков
-    leaderboard.push_back({ "Player", 0, true });
-
-    // Сортировка по убыванию очков
-    std::stable_sort(leaderboard.begin(), leaderboard.end(),
-        [](const ScoreEntry& a, const ScoreEntry& b) 
-        {
-            return a.score > b.score;
-        });
-
-    leaderboardInitialized = true;
 }
 
-void Game::setPlayerScoreToLeaderboard(int value)
+// Сохраняет результат завершенной партии (запись идет в фоновом потоке)
+void Game::commitPlayerScore()
 {
-    // Гарантированно один Player в таблице
-    auto it = std::find_if(leaderboard.begin(), leaderboard.end(),
-        [](const ScoreEntry& e) { return e.isPlayer; });
+    // Партии бота (F2, attract, --soak) не попадают ни в таблицу, ни на диск
+    if (playerScoreCommitted || botGame) return;
+    setPlayerScoreToLeaderboard(score);
+    leaderboardStore.append("Player", score);
+    playerScoreCommitted = true;
+}
 
-    if (it == leaderboard.end()) 
+// Новая партия: сохраненный результат остается в таблице как история
+void Game::startLeaderboardEntry()
+{
+    if (botGame) return;
+    if (playerScoreCommitted)
     {
-        leaderboard.push_back({ "Player", value, true });
+        playerEntryId = leaderboardIndex.insert("Player", 0);
+        leaderboardDirty = true;
     }
-    else 
+    else
     {
-        it->score = value;
+        setPlayerScoreToLeaderboard(0);
     }
+    playerScoreCommitted = false;
+}
 
-    // Пересортировать по убыванию
-    std::stable_sort(leaderboard.begin(), leaderboard.end(),
-        [](const ScoreEntry& a, const ScoreEntry& b) 
-        {
-            return a.score > b.score;
-        });
+// Обновляет очки игрока в индексе за O(log n), без пересортировки таблицы
+void Game::setPlayerScoreToLeaderboard(int value)
+{
+    if (leaderboardIndex.getScore(playerEntryId) == value) return;
+    leaderboardIndex.update(playerEntryId, value);
+    leaderboardDirty = true;
 }
 
-void Game::buildLeaderboardRows(std::vector<std::pair<std::string, int>>& outRows, int& outPlayerIndex) const
+// Пересчитывает видимые строки и место игрока после изменения таблицы
+void Game::refreshLeaderboardCache()
 {
-    outRows.clear();
-    outRows.reserve(leaderboard.size());
-    outPlayerIndex = -1;
+    if (!leaderboardDirty) return;
 
-    for (size_t i = 0; i < leaderboard.size(); ++i) 
+    buildLeaderboardRows(leaderboardRows, playerRowIndex);
+    if (playerEntryId >= 0)
     {
-        outRows.emplace_back(leaderboard[i].name, leaderboard[i].score);
-        if (leaderboard[i].isPlayer) outPlayerIndex = static_cast<int>(i);
+        playerRank = leaderboardIndex.rankOf(playerEntryId);
+        playerTopPercent = leaderboardIndex.topPercentOf(playerEntryId);
     }
+    leaderboardDirty = false;
+}
+
+void Game::buildLeaderboardRows(std::vector<std::pair<std::string, int>>& outRows, int& outPlayerIndex) const
+{
+    leaderboardIndex.topK(Constants::LEADERBOARD_VISIBLE_ROWS, outRows, playerEntryId, outPlayerIndex);
+}
+
+// Таблица под заголовком Game Over / Win и место игрока среди всей истории
+void Game::drawEndScreenLeaderboard()
+{
+    // Обновляет очки игрока (при неизменных очках ничего не делает); бот в таблицу не пишет
+    if (!botGame) setPlayerScoreToLeaderboard(score);
+    refreshLeaderboardCache();
+
+    const float tableStartY =
+        gameOverText.getPosition().y
+        + gameOverText.getLocalBounds().height * 0.5f
+        + Constants::LEADERBOARD_GAP_FROM_TITLE;
+
+    uiHandler.drawLeaderboard(renderTarget, leaderboardRows, playerRowIndex, tableStartY, Constants::LEADERBOARD_VISIBLE_ROWS);
+
+    // Строка с местом сразу под последней строкой таблицы
+    const float rankY = std::min(tableStartY + 44.f + leaderboardRows.size() * 28.f,
+        Constants::SCREEN_HEIGHT - 14.f);
+    uiHandler.drawPlayerRank(renderTarget, playerRank, playerTopPercent, rankY);
 }
 
 // Обновление
 void Game::update(float deltaTime)
 {
-    // Обновляет режим игры с ограниченными яблоками
-    if (HasGameMode(gameModeMask, GameMode::LIMITED_APPLES))
-    {
-        bool allCollected = std::all_of(apples.begin(), apples.end(), [](const std::unique_ptr<Apple>& a)
-            {
-                return !a->active;
-            });
+    updateLoading();
+    if (state == LOADING) return;
 
-        if (allCollected && state == PLAYING)
-        {
-            triggerWin();
-            return;
-        }
+    // Attract-режим запускает партию бота из главного меню тем же переходом, что и Enter
+    if (attractMode && state == MAIN_MENU && gameplayResourcesReady && !isTransitioning)
+    {
+        gameModeMask = AUTOPILOT_MODE_MASK;
+        isTransitioning = true;
+        fadeAlpha = 0.0f;
     }
 
     // Обновляет камера шейк
@@ -900,26 +1612,8 @@ void Game::update(float deltaTime)
             return; // пропускает первую проверку столкновений и апдейтов
         }
 
-        handlePlayerInput();
-        player.update(deltaTime);
-        checkBoundaries();
-        checkObstaclesCollision();
-        checkAppleCollision();
-        updateBonusApple();
-
-        // Обновляет противников только в режиме PLAYING
-        for (auto& enemy : enemies) 
-        {
-            enemy->update(deltaTime, obstacles);
-
-            if (Collision::circleCollide(player, *enemy,
-                Constants::PLAYER_SIZE / 2, Constants::PLAYER_SIZE / 2))
-            {
-                triggerGameOver(CollisionType::Enemy);
-                activateCameraShake();
-            }
-        }
-
+        // Тик, выбранный под режим игры в reset()
+        (this->*tickFunction)(deltaTime);
     }
     else if (state == GAME_OVER)
     {
@@ -932,7 +1626,7 @@ void Game::update(float deltaTime)
     }
 
     // Затемнение экрана
-    window.draw(gameOverOverlay);
+    renderTarget.draw(gameOverOverlay);
 
     // Плавный рендер текста
     float textAlpha = std::min(gameOverFadeAlpha * 2.0f, 255.0f);
@@ -941,9 +1635,9 @@ void Game::update(float deltaTime)
     // Рендер текста с эффектом шейка
     const float offset = 2.0f * (gameOverFadeAlpha / 255.0f);
     gameOverText.setPosition(Constants::SCREEN_WIDTH / 2 + offset, Constants::SCREEN_HEIGHT / 2);
-    window.draw(gameOverText);
+    renderTarget.draw(gameOverText);
     gameOverText.setPosition(Constants::SCREEN_WIDTH / 2 - offset, Constants::SCREEN_HEIGHT / 2);
-    window.draw(gameOverText);
+    renderTarget.draw(gameOverText);
 
     if (state == GAME_OVER && isFadingObjects)
     {
@@ -988,129 +1682,87 @@ void Game::update(float deltaTime)
 // Ренедер всех объектов и UI
 void Game::render() 
 {
-    window.clear();
+    renderTarget.clear();
 
-    sf::View originalView = window.getView();
+    sf::View originalView = renderTarget.getView();
 
     // Применение камера шейка
     if (shakeTimer > 0.0f) 
     {
         sf::View shakeView = originalView;
         shakeView.move(cameraShakeOffset);
-        window.setView(shakeView);
+        renderTarget.setView(shakeView);
     }
 
-    if (state == MAIN_MENU) 
+    if (state == LOADING)
+    {
+        renderTarget.beginPass("menu");
+        drawLoadingScreen();
+        presentFrame();
+        return;
+    }
+    else if (state == MAIN_MENU) 
     {
-        uiHandler.drawMainMenu(window);
-        if (isTransitioning) window.draw(fadeOverlay);
-        window.display();
+        renderTarget.beginPass("menu");
+        uiHandler.drawMainMenu(renderTarget);
+        if (isTransitioning) renderTarget.draw(fadeOverlay);
+        presentFrame();
         return;
     }
     else if (state == LEADERBOARD)
     {
-        std::vector<std::pair<std::string, int>> rows;
-        int playerIndex = -1;
-        buildLeaderboardRows(rows, playerIndex);
-
-        uiHandler.drawLeaderboardScreen(window, rows, playerIndex);
-        window.display();
+        renderTarget.beginPass("menu");
+        refreshLeaderboardCache();
+        uiHandler.drawLeaderboardScreen(renderTarget, leaderboardRows, playerRowIndex);
+        presentFrame();
         return;
     }
 
     // Рендер игровых объектов
+    renderTarget.beginPass("world");
     if (state != MAIN_MENU) 
     {
-        std::vector<sf::Color> originalColors;
-
-        // При паузе сохраняет оригинальный цвет и устанавливает градации серого
-        if (state == PAUSED) 
-        {
-            originalColors.push_back(player.sprite.getColor());
-            player.sprite.setColor(sf::Color(Constants::GRAY_COLOR_4));
-
-            // Устанавливаем серый цвет для яблок
-            for (auto& apple : apples) 
-            {
-                originalColors.push_back(apple->getColor());
-                apple->setColor(sf::Color(Constants::GRAY_COLOR));
-            }
-
-            // Устанавливаем серый цвет для препятствий
-            for (auto& obstacle : obstacles) 
-            {
-                originalColors.push_back(obstacle->getColor());
-                obstacle->setColor(sf::Color(Constants::GRAY_COLOR_3));
-            }
-
-            // Устанавливаем серый цвет для противников
-            for (auto& enemy : enemies) 
-            {
-                originalColors.push_back(enemy->getColor());
-                enemy->setColor(sf::Color(Constants::GRAY_COLOR_2));
-            }
-        }
-
-        for (const auto& apple : apples) apple->draw(window);
-        for (const auto& obstacle : obstacles) obstacle->draw(window);
-        player.draw(window);
-        if (bonusApple) bonusApple->draw(window);
-        for (const auto& enemy : enemies) enemy->draw(window);
-
-        // Восстанавливаем оригинальный цвет
-        if (state == PAUSED) 
-        {
-            size_t index = 0;
-            player.sprite.setColor(originalColors[index++]);
-            for (auto& apple : apples) apple->setColor(originalColors[index++]);
-            for (auto& obstacle : obstacles) obstacle->setColor(originalColors[index++]);
-            for (auto& enemy : enemies) enemy->setColor(originalColors[index++]);
-        }
+        // Серый цвет паузы уже применен в setPauseTint()
+        for (auto& apple : apples) apple.draw(renderTarget);
+
+        // Препятствия выводятся одним спрайтом из кэша статического слоя
+        staticLayer.draw(renderTarget, obstacles,
+            state == PAUSED ? Constants::GRAY_COLOR_3 : sf::Color::Transparent);
+        player.draw(renderTarget);
+        for (auto& bonusApple : bonusApples) bonusApple.draw(renderTarget);
+        for (auto& enemy : enemies) enemy.draw(renderTarget);
+        swarm.draw(renderTarget, enemyTexture,
+            state == PAUSED ? sf::Color(Constants::GRAY_COLOR_2) : sf::Color::White);
 
         if (state == GAME_OVER) 
         {
-            player.draw(window);
+            player.draw(renderTarget);
         }
         else 
         {
-            player.draw(window);
+            player.draw(renderTarget);
         }
     }
 
-    window.setView(originalView);
+    renderTarget.setView(originalView);
+    capture.captureWindow(window, FrameCapture::Layer::WORLD);
+    renderTarget.beginPass("hud");
 
     // Рендер очков
-    scoreText.setString("Score: " + std::to_string(score));
-    window.draw(scoreText);
+    UIHandler::setTextIfChanged(scoreText, shownScoreText, frameArena.format("Score: %d", score));
+    renderTarget.draw(scoreText);
 
     if (state == PAUSED) 
     {
-        uiHandler.drawPauseMenu(window);
+        uiHandler.drawPauseMenu(renderTarget);
     }
     else if (state == GAME_OVER)
     {
-        window.draw(gameOverOverlay);
+        renderTarget.draw(gameOverOverlay);
         drawGameOverScreen();
 
-        // Обновляет очки игрока и пересортировывает таблицу
-        setPlayerScoreToLeaderboard(score);
-
-        std::vector<std::pair<std::string, int>> rows;
-        rows.reserve(leaderboard.size());
-        int playerIndex = -1;
-        for (size_t i = 0; i < leaderboard.size(); ++i) 
-        {
-            rows.emplace_back(leaderboard[i].name, leaderboard[i].score);
-            if (leaderboard[i].isPlayer) playerIndex = static_cast<int>(i);
-        }
-
         // Рендер таблицы под заголовком Game Over
-        const float tableStartY =
-            gameOverText.getPosition().y
-            + gameOverText.getLocalBounds().height * 0.5f
-            + Constants::LEADERBOARD_GAP_FROM_TITLE;
-
-        uiHandler.drawLeaderboard(window, rows, playerIndex, tableStartY, 10);
+        drawEndScreenLeaderboard();
     }
 
     // Рендер экрана победы
@@ -1122,31 +1774,72 @@ void Game::render()
             winSoundPlayed = true;
         }
 
-        window.draw(gameOverOverlay);
+        renderTarget.draw(gameOverOverlay);
         drawWinScreen();
 
-        // Обновляет очки игрока и пересортировывает таблицу
-        setPlayerScoreToLeaderboard(score);
+        // Рендер таблицы под заголовком Win
+        drawEndScreenLeaderboard();
+    }
 
-        std::vector<std::pair<std::string, int>> rows;
-        rows.reserve(leaderboard.size());
-        int playerIndex = -1;
-        for (size_t i = 0; i < leaderboard.size(); ++i) 
-        {
-            rows.emplace_back(leaderboard[i].name, leaderboard[i].score);
-            if (leaderboard[i].isPlayer) playerIndex = static_cast<int>(i);
-        }
+    if (isTransitioning) renderTarget.draw(fadeOverlay);
 
-        // Рендер таблицы под заголовком Win
-        const float tableStartY =
-            gameOverText.getPosition().y
-            + gameOverText.getLocalBounds().height * 0.5f
-            + Constants::LEADERBOARD_GAP_FROM_TITLE;
+    presentFrame();
+}
 
-        uiHandler.drawLeaderboard(window, rows, playerIndex, tableStartY, 10);
+// Запуск или остановка записи; другая клавиша во время записи меняет точку снятия
+void Game::toggleCapture(FrameCapture::Layer layer)
+{
+    const bool sameLayer = capture.isActive() && capture.getLayer() == layer;
+    capture.stop();
+    if (sameLayer) return;
+
+    // Новая запись - новый файл: capture_ГГГГММДД_ччммсс
+    char prefix[64];
+    const std::time_t now = std::time(nullptr);
+    std::strftime(prefix, sizeof(prefix), "_%Y%m%d_%H%M%S", std::localtime(&now));
+
+    const sf::Vector2u size = window.getSize();
+    if (capture.start(Constants::CAPTURE_PREFIX + prefix, static_cast<int>(size.x), static_cast<int>(size.y),
+        FrameCapture::Format::RAW_VIDEO, layer, Constants::CAPTURE_FRAME_RATE))
+    {
+        std::printf("Capture started (%s)\n", layer == FrameCapture::Layer::WITH_UI ? "with UI" : "world only");
+    }
+    else
+    {
+        std::fprintf(stderr, "Capture failed: cannot open %s%s.rgba\n", Constants::CAPTURE_PREFIX.c_str(), prefix);
     }
+}
 
-    if (isTransitioning) window.draw(fadeOverlay);
+// Показывает кадр и освобождает временные данные кадра
+void Game::presentFrame()
+{
+    renderTarget.beginPass("overlay");
+    if (debugOverlay.isVisible() && menuResourcesReady)
+    {
+        DebugOverlay::SceneStats scene;
+        scene.apples = counters.activeApples;
+        scene.enemies = counters.enemies;
+        scene.obstacles = counters.obstacles;
+        scene.bonusApples = counters.bonusApples;
+        scene.grid = appleGrid.getOccupancy();
+        scene.allocations = lastAllocations;
+        debugOverlay.draw(renderTarget, font, scene);
+    }
+    if (AllocationTracker::ENABLED && menuResourcesReady)
+    {
+        AllocationTracker::Scope other(AllocationTracker::Subsystem::Other);
+        renderTarget.draw(allocationText);
+    }
 
+    // Кадр считается от показа до показа, включая отрисовку из update()
+    renderTarget.endFrame();
+    if (renderStatsDumpRequested)
+    {
+        renderTarget.dump(stdout);
+        renderStatsDumpRequested = false;
+    }
+    capture.captureWindow(window, FrameCapture::Layer::WITH_UI);
     window.display();
+    frameArena.reset();
+    renderTarget.beginFrame();
 }
\ No newline at end of file
@@ -50,30 +50,78 @@
 #include "Constants.h"
 #include "Ui.h"
 #include "Enemy.h"
+#include "SlotMap.h"
 #include "SpatialGrid.h"
+#include "StaticLayer.h"
+#include "FlowField.h"
+#include "Swarm.h"
+#include "MovementSystem.h"
+#include "SpatialQuery.h"
+#include "Autopilot.h"
+#include "GameRaster.h"
+#include "FrameCapture.h"
+#include "ResourceLoader.h"
+#include "LeaderboardStore.h"
+#include "LeaderboardIndex.h"
+#include "CollisionSystem.h"
+#include "EntityCounters.h"
+#include "AllocationTracker.h"
+#include "DebugOverlay.h"
 
 class Game 
 {
 private:
-    struct ScoreEntry
-    {
-        std::string name;
-        int score;
-        bool isPlayer;
-    };
-
     SpatialGrid appleGrid;
-    std::vector<int> appleCandidates;
+    std::vector<SlotHandle> appleCandidates;
+    std::vector<CollisionEvent> collisionEvents; //    
+    StaticLayer staticLayer;
+    FlowField flowField; //      CHASE
+    Swarm swarm;         //    SWARM
+    MovementSystem movement; //      
 
     sf::RenderWindow window;
+    CountingRenderTarget renderTarget; //       (  )
+    bool renderStatsDumpRequested = false; // F4
+    OccupancyRaster occupancy;             // F5:      
+    FrameCapture capture;                  // F6:   , F7:  
     Player player;
+    FrameArena frameArena; //   ,   presentFrame()
     UIHandler uiHandler;
     GameState state = PLAYING;
-    std::vector<std::unique_ptr<Apple>> apples;
-    std::vector<std::unique_ptr<Obstacle>> obstacles;
-    std::vector<std::unique_ptr<Enemy>> enemies;
-    std::unique_ptr<BonusApple> bonusApple;
-    std::vector<ScoreEntry> leaderboard;
+    SlotMap<Apple> apples;
+    SlotMap<Obstacle> obstacles;
+    SlotMap<Enemy> enemies;
+    SlotMap<BonusApple> bonusApples; //     
+    SlotHandle bonusAppleHandle;
+
+    //    ;    (, , )   
+    SpatialGrid enemyGrid;
+    SpatialGrid obstacleGrid;
+    SpatialQuery spatialQuery{ apples, appleGrid, enemies, enemyGrid, obstacles, obstacleGrid };
+
+    //      (F2); attract-     
+    Autopilot autopilot;
+    bool autopilotEnabled = false;
+    bool attractMode = false;
+    bool botGame = false; //     :      
+    CollisionType gameOverCause = CollisionType::Boundary; //    
+    LeaderboardIndex leaderboardIndex;
+    std::vector<std::pair<std::string, int>> leaderboardRows;
+    int playerEntryId = -1;
+
+    //     :     
+    int playerRowIndex = -1;
+    int playerRank = 0;
+    float playerTopPercent = 0.0f;
+    bool leaderboardDirty = true;
+    void refreshLeaderboardCache();
+
+    //      ,    
+    EntityCounters counters;
+    std::vector<sf::Color> pausedColors;
+    bool pauseTinted = false;
+    void setPauseTint(bool enabled);
+    LeaderboardStore leaderboardStore{ Constants::LEADERBOARD_LOG, Constants::LEADERBOARD_SNAPSHOT };
     
     int score = 0;
     int lastBonusScore = 0;
@@ -88,6 +136,9 @@ private:
     bool winSoundPlayed = false;
     bool justStarted = true;
     bool leaderboardInitialized = false;
+    bool playerScoreCommitted = false;
+    bool menuResourcesReady = false;
+    bool gameplayResourcesReady = false;
 
     float fadeAlpha = 0.0f;
     float blinkTimer = 0.0f;
@@ -105,11 +156,17 @@ private:
     sf::Clock gameOverBlinkClock;
     sf::Clock scoreColorClock;
     sf::Clock winTimer;
+
+    //     :   ,  sf::Music
+    //      
+    ResourcePack resourcePack;
+    ResourceLoader loader;
     sf::Music menuMusic;
     sf::Music backgroundMusic;
     sf::Music endMusic;
-
     sf::Font font;
+    sf::Texture playerTexture;
+    sf::Texture enemyTexture;
     sf::SoundBuffer appleSoundBuffer;
     sf::SoundBuffer bonusSoundBuffer;
     sf::SoundBuffer gameOverSoundBuffer;
@@ -127,6 +184,12 @@ private:
     sf::Text continueText;
     sf::Text restartText;
     sf::Text gameOverText;
+    std::string shownScoreText;    //  ,   sf::Text
+    std::string shownGameOverText;
+    sf::Text allocationText;       //    (APPLES_ALLOC_TRACKING)
+    std::string shownAllocationText;
+    AllocationTracker::FrameStats lastAllocations;
+    DebugOverlay debugOverlay;     // F3
 
     sf::RectangleShape fadeOverlay;
     sf::RectangleShape gameOverOverlay;
@@ -136,13 +199,31 @@ private:
     sf::Vector2f randomPosition() const;
 
     void loadResources();
+    void openMusic(sf::Music& music, const std::string& name, const std::string& error);
+    void updateLoading();
+    void onMenuResourcesLoaded();
+    void onGameplayResourcesLoaded();
+    void drawLoadingScreen();
     void spawnApples();
     void spawnObstacles();
     void handlePlayerInput();
     void checkBoundaries();
     void checkObstaclesCollision();
     void checkAppleCollision();
-    void updateBonusApple();
+    void checkEnemiesCollision();
+    void checkSwarmCollision();
+    void collectBonusApple();
+
+    //   ,     (GameModePolicy)
+    using TickFunction = void (Game::*)(float);
+    TickFunction tickFunction = nullptr;
+    static TickFunction selectTick(int modeMask);
+    static const int MODE_FLAG_COUNT = 5; //  GameModePolicy
+    template <bool... Chosen> struct TickSelector;
+    template <typename Mode> void tick(float deltaTime);
+    template <typename Mode> void updateBonusApple();
+    template <typename Mode> void resolveCollisions();
+    template <typename Mode> void collectApple(SlotHandle handle);
     void triggerGameOver(CollisionType type);
     void drawGameOverScreen();
     void activateCameraShake();
@@ -150,14 +231,41 @@ private:
     void handlePauseAction(UIHandler::MenuAction action);
     void triggerWin();
     void drawWinScreen();
+    void presentFrame();
+    void toggleCapture(FrameCapture::Layer layer);
+    void togglePause();
+
+    //      ; handleInput = false -   ( )
+    AllocationTracker::FrameStats runFrame(float deltaTime, bool handleInput);
+    void drainEvents();
+    void reportAllocations(const AllocationTracker::FrameStats& stats);
+    void enterAllocationCheckPhase(GameState phase);
+    bool checkAllocationPhase(GameState phase, const char* name, int ticks);
+
     void initLeaderboardIfNeeded();
+    void seedLeaderboardWithBots();
     void setPlayerScoreToLeaderboard(int value);
+    void commitPlayerScore();
+    void drawEndScreenLeaderboard();
+    void startLeaderboardEntry();
     void buildLeaderboardRows(std::vector<std::pair<std::string, int>>& outRows, int& outPlayerIndex) const; // ,    UI   Player
 
 public:
     Game();
     void reset();
     void run();
+
+    //   : ticks    PLAYING, PAUSED  GAME_OVER,
+    // false -         Sim  UI
+    bool runAllocationCheck(int ticks);
+
+    // Attract-:     ,    
+    void enableAttractMode();
+
+    //       : ticks ,  
+    //     ;    stdout
+    void runSoak(int ticks);
+
     void handleEvents();
     void update(float deltaTime);
     void spawnEnemies();
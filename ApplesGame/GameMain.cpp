@@ -12,6 +12,16 @@
 - Инициализация главного класса Game
 - Запуск основного игрового цикла
 - Глобальная обработка исключений
+- Режим проверки выделений памяти: ApplesGame --alloc-check [кадров]
+- Бот-игрок: ApplesGame --attract (партии бота в окне до нажатия клавиши),
+  ApplesGame --soak [тиков] (прогон бота без отрисовки с итогами в stdout)
+- Оценка максимума очков на seed: ApplesGame --plan [seed] [тиков]
+  (Monte Carlo планировщик по SimState, без окна)
+- Пропускная способность среды обучения: ApplesGame --env-bench [партий] [тиков] [потоков] [raster]
+- Кадр без окна (миниатюра, эталон): ApplesGame --render [seed] [тиков] [файл]
+  (партия планировщика до тика, затем SoftwareRenderer)
+- Ролик без окна: ApplesGame --record [seed] [тиков] [префикс]
+  (каждый тик партии планировщика через SoftwareRenderer в PNG-кадры)
 
 Структура:
 1. Создание экземпляра игры в блоке try
@@ -24,14 +34,209 @@
 - Использование стандартных кодов возврата
 */
 
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
 #include <iostream>
 #include "Game.h"
+#include "AllocationTracker.h"
+#include "MonteCarloPlanner.h"
+#include "SoftwareRenderer.h"
+#include "FrameCapture.h"
+#include "VecEnv.h"
 
-int main()
+namespace
 {
+    const int PLAN_ROLLOUTS_PER_DIRECTION = 64;
+    const int PLAN_HORIZON_TICKS = 120;
+
+    // Партия планировщика на мире из seed (режим как у партий бота в --soak)
+    void runPlanner(std::uint32_t seed, int ticks)
+    {
+        const float deltaTime = 1.0f / 60.0f;
+        SimState state;
+        Sim::generate(state, UNLIMITED_APPLES | SPEED_UP, seed);
+
+        MonteCarloPlanner planner(PLAN_ROLLOUTS_PER_DIRECTION, PLAN_HORIZON_TICKS);
+        sf::Clock clock;
+        Direction direction = state.playerDirection;
+        for (int tick = 0; tick < ticks && state.alive && !state.won; ++tick)
+        {
+            if (tick % planner.getHoldTicks() == 0) direction = planner.decide(state);
+            Sim::step(state, direction, deltaTime);
+        }
+        const float seconds = clock.getElapsedTime().asSeconds();
+
+        std::printf("Plan: seed %u, %s after %d ticks (%.1f s of play), score %d, speed %.0f\n",
+            seed, state.alive ? "alive" : "died", state.ticks, state.ticks * deltaTime,
+            state.score, state.playerSpeed);
+        std::printf("Rollouts: %lld on %d threads, %.0f per second\n", planner.getRolloutCount(),
+            planner.getThreadCount(), seconds > 0.0f ? planner.getRolloutCount() / seconds : 0.0);
+    }
+
+    // Кадр партии планировщика на тике ticks - детерминирован для seed
+    bool renderFrame(std::uint32_t seed, int ticks, const std::string& path)
+    {
+        const float deltaTime = 1.0f / 60.0f;
+        SimState state;
+        Sim::generate(state, UNLIMITED_APPLES | SPEED_UP, seed);
+
+        MonteCarloPlanner planner(PLAN_ROLLOUTS_PER_DIRECTION, PLAN_HORIZON_TICKS);
+        Direction direction = state.playerDirection;
+        for (int tick = 0; tick < ticks && state.alive && !state.won; ++tick)
+        {
+            if (tick % planner.getHoldTicks() == 0) direction = planner.decide(state);
+            Sim::step(state, direction, deltaTime);
+        }
+
+        ResourcePack pack;
+        const bool packed = pack.open(Constants::RESOURCE_PACK);
+        SoftwareRenderer renderer;
+        renderer.loadSprites(packed ? &pack : nullptr);
+
+        sf::Clock clock;
+        renderer.render(state);
+        const float milliseconds = clock.getElapsedTime().asSeconds() * 1000.0f;
+        if (!renderer.saveToFile(path)) return false;
+
+        std::printf("Render: seed %u, tick %d, score %d -> %s (%dx%d, %.2f ms on %d threads)\n",
+            seed, state.ticks, state.score, path.c_str(), renderer.getWidth(), renderer.getHeight(),
+            milliseconds, renderer.getThreadCount());
+        return true;
+    }
+
+    // Партия планировщика кадр за кадром в последовательность PNG;
+    // false - запись не началась или часть кадров не записана
+    bool recordGame(std::uint32_t seed, int ticks, const std::string& prefix)
+    {
+        const float deltaTime = 1.0f / 60.0f;
+        SimState state;
+        Sim::generate(state, UNLIMITED_APPLES | SPEED_UP, seed);
+
+        ResourcePack pack;
+        const bool packed = pack.open(Constants::RESOURCE_PACK);
+        SoftwareRenderer renderer;
+        renderer.loadSprites(packed ? &pack : nullptr);
+
+        // Офлайн-запись ждет свободный буфер и берет каждый тик (частота 0):
+        // кадр может потеряться только при ошибке записи файла
+        FrameCapture capture;
+        if (!capture.start(prefix, renderer.getWidth(), renderer.getHeight(), FrameCapture::Format::IMAGE_SEQUENCE,
+            FrameCapture::Layer::WITH_UI, 0))
+        {
+            return false;
+        }
+
+        MonteCarloPlanner planner(PLAN_ROLLOUTS_PER_DIRECTION, PLAN_HORIZON_TICKS);
+        Direction direction = state.playerDirection;
+        for (int tick = 0; tick < ticks && state.alive && !state.won; ++tick)
+        {
+            if (tick % planner.getHoldTicks() == 0) direction = planner.decide(state);
+            Sim::step(state, direction, deltaTime);
+            renderer.render(state);
+            capture.capturePixels(renderer.getPixels(), true);
+        }
+        capture.stop();
+        return capture.getDroppedFrames() == 0;
+    }
+
+    // Шаги VecEnv со случайными действиями: шагов партий в секунду
+    void runEnvBenchmark(int envCount, int steps, int threadCount, bool rasterObservations)
+    {
+        VecEnv env(envCount, UNLIMITED_APPLES | SPEED_UP, threadCount, rasterObservations);
+        std::vector<int> actions(env.getEnvCount());
+        env.reset(1);
+
+        std::uint32_t random = 0x9E3779B9u;
+        long long episodes = 0;
+        sf::Clock clock;
+        for (int step = 0; step < steps; ++step)
+        {
+            // Действие держится несколько тиков, как у игрока
+            if (step % 10 == 0)
+            {
+                for (int& action : actions)
+                {
+                    random ^= random << 13;
+                    random ^= random >> 17;
+                    random ^= random << 5;
+                    action = static_cast<int>(random % 4);
+                }
+            }
+            const VecEnv::Batch batch = env.step(actions.data());
+            for (int i = 0; i < env.getEnvCount(); ++i) episodes += batch.dones[i];
+        }
+        const float seconds = clock.getElapsedTime().asSeconds();
+        const double envSteps = static_cast<double>(steps) * env.getEnvCount();
+
+        std::printf("VecEnv: %d envs x %d steps on %d threads, %lld episodes finished\n",
+            env.getEnvCount(), steps, env.getThreadCount(), episodes);
+        std::printf("Throughput: %.0f env steps per second, observation %d floats%s\n",
+            seconds > 0.0f ? envSteps / seconds : 0.0, VecEnv::OBSERVATION_SIZE,
+            rasterObservations ? " + occupancy raster" : "");
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    // Основной поток вне разметки кадра (загрузка, создание окна)
+    AllocationTracker::Scope mainThread(AllocationTracker::Subsystem::Other);
+
     try 
     {
+        // Планировщику окно не нужно: мир целиком в SimState
+        if (argc > 1 && std::strcmp(argv[1], "--plan") == 0)
+        {
+            const std::uint32_t seed = argc > 2 ? static_cast<std::uint32_t>(std::strtoul(argv[2], nullptr, 10)) : 1u;
+            const int ticks = argc > 3 ? std::max(1, std::atoi(argv[3])) : 10800;
+            runPlanner(seed, ticks);
+            return EXIT_SUCCESS;
+        }
+        if (argc > 1 && std::strcmp(argv[1], "--render") == 0)
+        {
+            const std::uint32_t seed = argc > 2 ? static_cast<std::uint32_t>(std::strtoul(argv[2], nullptr, 10)) : 1u;
+            const int ticks = argc > 3 ? std::max(0, std::atoi(argv[3])) : 600;
+            const std::string path = argc > 4 ? argv[4] : "frame.png";
+            return renderFrame(seed, ticks, path) ? EXIT_SUCCESS : EXIT_FAILURE;
+        }
+        if (argc > 1 && std::strcmp(argv[1], "--record") == 0)
+        {
+            const std::uint32_t seed = argc > 2 ? static_cast<std::uint32_t>(std::strtoul(argv[2], nullptr, 10)) : 1u;
+            const int ticks = argc > 3 ? std::max(1, std::atoi(argv[3])) : 600;
+            const std::string prefix = argc > 4 ? argv[4] : Constants::CAPTURE_PREFIX;
+            return recordGame(seed, ticks, prefix) ? EXIT_SUCCESS : EXIT_FAILURE;
+        }
+        if (argc > 1 && std::strcmp(argv[1], "--env-bench") == 0)
+        {
+            const int envCount = argc > 2 ? std::max(1, std::atoi(argv[2])) : 256;
+            const int steps = argc > 3 ? std::max(1, std::atoi(argv[3])) : 3600;
+            const int threadCount = argc > 4 ? std::atoi(argv[4]) : 1;
+            const bool raster = argc > 5 && std::strcmp(argv[5], "raster") == 0;
+            runEnvBenchmark(envCount, steps, threadCount, raster);
+            return EXIT_SUCCESS;
+        }
+
         Game game; // Создает экземпляр игры
+
+        // Прогон без ввода: ошибка, если устоявшийся кадр выделяет память
+        if (argc > 1 && std::strcmp(argv[1], "--alloc-check") == 0)
+        {
+            const int ticks = argc > 2 ? std::max(1, std::atoi(argv[2])) : 600;
+            return game.runAllocationCheck(ticks) ? EXIT_SUCCESS : EXIT_FAILURE;
+        }
+        if (argc > 1 && std::strcmp(argv[1], "--soak") == 0)
+        {
+            const int ticks = argc > 2 ? std::max(1, std::atoi(argv[2])) : 36000;
+            game.runSoak(ticks);
+            return EXIT_SUCCESS;
+        }
+        if (argc > 1 && std::strcmp(argv[1], "--attract") == 0)
+        {
+            game.enableAttractMode();
+        }
+
         game.run(); // Запускает главный цикл
     }
     catch (const std::exception& e)
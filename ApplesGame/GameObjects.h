@@ -30,12 +30,13 @@
 
 #pragma once
 #include <SFML/Graphics.hpp>
+#include "CountingRenderTarget.h"
 
 class GameObject
 {
 public:
     sf::Vector2f position; //  
-    virtual void draw(sf::RenderWindow& window) = 0; //    
+    virtual void draw(CountingRenderTarget& window) = 0; //    
     virtual sf::FloatRect getBounds() const = 0; //  
     virtual ~GameObject() = default; // 
 };
\ No newline at end of file
@@ -0,0 +1,27 @@
+﻿#include "GameRaster.h"
+#include "Constants.h"
+
+void rasterizeGame(OccupancyRaster& raster, const Player& player, const SlotMap<Apple>& apples,
+    const SlotMap<Obstacle>& obstacles, const SlotMap<Enemy>& enemies, const SlotMap<BonusApple>& bonusApples,
+    const Swarm& swarm)
+{
+    raster.clear();
+    for (const auto& obstacle : obstacles)
+    {
+        raster.fillRect(OccupancyRaster::OBSTACLES, obstacle.position, obstacle.position + obstacle.getSize());
+    }
+    for (const auto& apple : apples) raster.stampDisc(OccupancyRaster::APPLES, apple.position, Constants::APPLE_SIZE / 2.0f);
+    for (const auto& enemy : enemies) raster.stampDisc(OccupancyRaster::ENEMIES, enemy.position, Constants::PLAYER_SIZE / 2.0f);
+    for (const auto& bonusApple : bonusApples)
+    {
+        raster.stampDisc(OccupancyRaster::BONUS, bonusApple.position, Constants::APPLE_SIZE / 2.0f);
+    }
+
+    const std::vector<float>& swarmX = swarm.getPositionsX();
+    const std::vector<float>& swarmY = swarm.getPositionsY();
+    for (std::size_t i = 0; i < swarmX.size(); ++i)
+    {
+        raster.stampDisc(OccupancyRaster::ENEMIES, sf::Vector2f(swarmX[i], swarmY[i]), Constants::SWARM_RADIUS);
+    }
+    raster.stampDisc(OccupancyRaster::PLAYER, player.position, Constants::PLAYER_SIZE / 2.0f);
+}
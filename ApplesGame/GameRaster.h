@@ -0,0 +1,20 @@
+﻿/*
+Растр занятости живой партии - те же каналы, что у rasterize(SimState),
+но прямо из объектов Game, вместе с бонусными яблоками и роем (F5).
+Отдельно от OccupancyRaster.h, чтобы тот не тянул игровые объекты.
+*/
+
+#pragma once
+#include "OccupancyRaster.h"
+#include "Player.h"
+#include "Apple.h"
+#include "BonusApple.h"
+#include "Enemy.h"
+#include "Obstacle.h"
+#include "SlotMap.h"
+#include "Swarm.h"
+
+// Весь мир в текущей области raster (с clear())
+void rasterizeGame(OccupancyRaster& raster, const Player& player, const SlotMap<Apple>& apples,
+    const SlotMap<Obstacle>& obstacles, const SlotMap<Enemy>& enemies, const SlotMap<BonusApple>& bonusApples,
+    const Swarm& swarm);
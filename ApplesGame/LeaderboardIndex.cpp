@@ -0,0 +1,90 @@
+﻿#include <algorithm>
+#include "LeaderboardIndex.h"
+
+int LeaderboardIndex::insert(const std::string& name, int score)
+{
+    score = std::max(score, 0);
+    const int id = static_cast<int>(slots.size());
+    slots.push_back({ name, score, ordered.emplace(score, id) });
+    addCount(score, 1);
+    return id;
+}
+
+void LeaderboardIndex::update(int id, int score)
+{
+    score = std::max(score, 0);
+    Slot& slot = slots[id];
+    if (slot.score == score) return;
+
+    addCount(slot.score, -1);
+    ordered.erase(slot.position);
+
+    slot.score = score;
+    slot.position = ordered.emplace(score, id);
+    addCount(score, 1);
+}
+
+int LeaderboardIndex::getScore(int id) const
+{
+    return slots[id].score;
+}
+
+int LeaderboardIndex::rankOf(int id) const
+{
+    const int better = size() - countAtMost(slots[id].score);
+    return better + 1;
+}
+
+float LeaderboardIndex::topPercentOf(int id) const
+{
+    if (slots.empty()) return 0.0f;
+    const int notWorse = size() - countAtMost(slots[id].score - 1);
+    return 100.0f * notWorse / size();
+}
+
+void LeaderboardIndex::topK(int k, std::vector<std::pair<std::string, int>>& outRows,
+    int highlightId, int& highlightIndex) const
+{
+    outRows.clear();
+    highlightIndex = -1;
+
+    for (auto it = ordered.begin(); it != ordered.end() && static_cast<int>(outRows.size()) < k; ++it)
+    {
+        if (it->second == highlightId) highlightIndex = static_cast<int>(outRows.size());
+        outRows.emplace_back(slots[it->second].name, it->first);
+    }
+}
+
+// Дерево Фенвика растет удвоением и пересчитывается по текущим очкам записей
+void LeaderboardIndex::grow(int score)
+{
+    int capacity = std::max<int>(static_cast<int>(tree.size()) - 1, 256);
+    while (capacity <= score) capacity *= 2;
+
+    tree.assign(capacity + 1, 0);
+    for (const auto& slot : slots)
+    {
+        for (int i = slot.score + 1; i <= capacity; i += i & -i) ++tree[i];
+    }
+}
+
+void LeaderboardIndex::addCount(int score, int delta)
+{
+    const int capacity = static_cast<int>(tree.size()) - 1;
+    if (score >= capacity)
+    {
+        // Перестройка уже учитывает запись с новыми очками
+        grow(score);
+        return;
+    }
+    for (int i = score + 1; i <= capacity; i += i & -i) tree[i] += delta;
+}
+
+int LeaderboardIndex::countAtMost(int score) const
+{
+    if (score < 0) return 0;
+    const int capacity = static_cast<int>(tree.size()) - 1;
+    int sum = 0;
+    for (int i = std::min(score + 1, capacity); i > 0; i -= i & -i) sum += tree[i];
+    return sum;
+}
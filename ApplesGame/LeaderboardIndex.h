@@ -0,0 +1,58 @@
+﻿/*
+Индекс таблицы рекордов с порядковой статистикой.
+
+- Дерево Фенвика по значениям очков: место и процентиль за O(log n)
+  без сортировки всей истории.
+- std::multimap очки -> запись: вставка/обновление за O(log n),
+  первые K строк перебираются за O(K).
+- Записи не удаляются; текущий игрок обновляет свою запись через update().
+*/
+
+#pragma once
+#include <functional>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+class LeaderboardIndex
+{
+public:
+    // Добавляет запись, возвращает ее идентификатор
+    int insert(const std::string& name, int score);
+
+    // Меняет очки записи (ничего не делает, если очки те же)
+    void update(int id, int score);
+
+    int getScore(int id) const;
+
+    // Место записи (1 - лучшее; равные очки делят место)
+    int rankOf(int id) const;
+
+    // Доля записей с очками не хуже, в процентах ("top 3%")
+    float topPercentOf(int id) const;
+
+    int size() const { return static_cast<int>(slots.size()); }
+
+    // Первые k строк по убыванию очков; highlightIndex - позиция записи highlightId или -1
+    void topK(int k, std::vector<std::pair<std::string, int>>& outRows,
+        int highlightId, int& highlightIndex) const;
+
+private:
+    using Ordered = std::multimap<int, int, std::greater<int>>;
+
+    struct Slot
+    {
+        std::string name;
+        int score;
+        Ordered::iterator position;
+    };
+
+    std::vector<Slot> slots;
+    Ordered ordered;
+    std::vector<int> tree; // дерево Фенвика, tree[i] для очков i - 1
+
+    void addCount(int score, int delta);
+    int countAtMost(int score) const;
+    void grow(int score);
+};
@@ -0,0 +1,317 @@
+﻿#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include "LeaderboardStore.h"
+#include "MappedFile.h"
+#include "Checksum.h"
+#include "AllocationTracker.h"
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+namespace
+{
+    const std::uint32_t LOG_MAGIC = 0x4352424C;      // "LBRC"
+    const std::uint32_t SNAPSHOT_MAGIC = 0x4E53424C; // "LBSN"
+    const std::uint32_t SNAPSHOT_VERSION = 1;
+    const std::size_t SNAPSHOT_HEADER_SIZE = 24;
+    const std::size_t SNAPSHOT_NAME_SIZE = 24;
+    const std::size_t SNAPSHOT_RECORD_SIZE = 16 + SNAPSHOT_NAME_SIZE;
+    const std::size_t LOG_RECORD_FIXED_SIZE = 4 + 8 + 4 + 8 + 1;
+    const int COMPACT_THRESHOLD = 64; // записей в журнале до сжатия
+    const int LOG_WRITE_ATTEMPTS = 3;
+    const int LOG_RETRY_DELAY_MS = 50;
+
+    template <typename T>
+    void put(std::vector<unsigned char>& out, T value)
+    {
+        const unsigned char* p = reinterpret_cast<const unsigned char*>(&value);
+        out.insert(out.end(), p, p + sizeof(T));
+    }
+
+    template <typename T>
+    T get(const unsigned char* p)
+    {
+        T value;
+        std::memcpy(&value, p, sizeof(T));
+        return value;
+    }
+
+    // Сбрасывает данные файла на носитель
+    bool syncFile(std::FILE* file)
+    {
+        if (std::fflush(file) != 0) return false;
+#ifdef _WIN32
+        return _commit(_fileno(file)) == 0;
+#else
+        return fsync(fileno(file)) == 0;
+#endif
+    }
+
+    // Атомарно заменяет target файлом source
+    bool replaceFile(const std::string& source, const std::string& target)
+    {
+#ifdef _WIN32
+        return MoveFileExA(source.c_str(), target.c_str(),
+            MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH) != 0;
+#else
+        return std::rename(source.c_str(), target.c_str()) == 0;
+#endif
+    }
+
+    bool byScoreDesc(const LeaderboardRecord& a, const LeaderboardRecord& b)
+    {
+        return a.score > b.score;
+    }
+}
+
+LeaderboardStore::LeaderboardStore(const std::string& logPath, const std::string& snapshotPath)
+    : logPath(logPath), snapshotPath(snapshotPath)
+{
+}
+
+LeaderboardStore::~LeaderboardStore()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopRequested = true;
+    }
+    wakeUp.notify_one();
+    if (worker.joinable()) worker.join();
+}
+
+std::vector<LeaderboardRecord> LeaderboardStore::load()
+{
+    records.clear();
+    std::uint64_t lastSequence = 0;
+    loadSnapshot(lastSequence);
+    loadLog(lastSequence);
+
+    std::stable_sort(records.begin(), records.end(), byScoreDesc);
+    std::vector<LeaderboardRecord> result = records;
+
+    if (!worker.joinable())
+    {
+        worker = std::thread(&LeaderboardStore::writerLoop, this);
+    }
+    return result;
+}
+
+void LeaderboardStore::append(const std::string& name, int score)
+{
+    LeaderboardRecord record;
+    record.name = name.substr(0, SNAPSHOT_NAME_SIZE - 1);
+    record.score = score;
+    record.timestamp = std::chrono::duration_cast<std::chrono::seconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        queue.push_back(std::move(record));
+    }
+    wakeUp.notify_one();
+}
+
+void LeaderboardStore::loadSnapshot(std::uint64_t& lastSequence)
+{
+    MappedFile file;
+    if (!file.open(snapshotPath)) return;
+
+    const unsigned char* base = file.getData();
+    if (file.getSize() < SNAPSHOT_HEADER_SIZE
+        || get<std::uint32_t>(base) != SNAPSHOT_MAGIC
+        || get<std::uint32_t>(base + 4) != SNAPSHOT_VERSION)
+        return;
+
+    const std::uint32_t count = get<std::uint32_t>(base + 8);
+    const std::uint32_t crc = get<std::uint32_t>(base + 12);
+    const std::size_t payload = static_cast<std::size_t>(count) * SNAPSHOT_RECORD_SIZE;
+    if (file.getSize() < SNAPSHOT_HEADER_SIZE + payload
+        || Checksum::crc32(base + SNAPSHOT_HEADER_SIZE, payload) != crc)
+        return;
+
+    lastSequence = get<std::uint64_t>(base + 16);
+    nextSequence = lastSequence + 1;
+
+    records.reserve(count);
+    const unsigned char* p = base + SNAPSHOT_HEADER_SIZE;
+    for (std::uint32_t i = 0; i < count; ++i, p += SNAPSHOT_RECORD_SIZE)
+    {
+        LeaderboardRecord record;
+        record.score = get<std::int32_t>(p);
+        record.timestamp = get<std::int64_t>(p + 8);
+        const char* name = reinterpret_cast<const char*>(p + 16);
+        record.name.assign(name, strnlen(name, SNAPSHOT_NAME_SIZE));
+        records.push_back(std::move(record));
+    }
+}
+
+void LeaderboardStore::loadLog(std::uint64_t lastSequence)
+{
+    MappedFile file;
+    if (!file.open(logPath)) return;
+
+    const unsigned char* p = file.getData();
+    const unsigned char* end = p + file.getSize();
+    bool damagedTail = false;
+
+    while (p < end)
+    {
+        if (static_cast<std::size_t>(end - p) < LOG_RECORD_FIXED_SIZE || get<std::uint32_t>(p) != LOG_MAGIC)
+        {
+            damagedTail = true;
+            break;
+        }
+        const std::size_t nameLength = p[LOG_RECORD_FIXED_SIZE - 1];
+        const std::size_t recordSize = LOG_RECORD_FIXED_SIZE + nameLength + 4;
+        if (static_cast<std::size_t>(end - p) < recordSize
+            || Checksum::crc32(p, recordSize - 4) != get<std::uint32_t>(p + recordSize - 4))
+        {
+            damagedTail = true;
+            break;
+        }
+
+        LeaderboardRecord record;
+        record.sequence = get<std::uint64_t>(p + 4);
+        record.score = get<std::int32_t>(p + 12);
+        record.timestamp = get<std::int64_t>(p + 16);
+        record.name.assign(reinterpret_cast<const char*>(p + LOG_RECORD_FIXED_SIZE), nameLength);
+        p += recordSize;
+
+        // Записи, уже вошедшие в снимок (сбой между rename и очисткой журнала)
+        if (record.sequence <= lastSequence) continue;
+
+        nextSequence = std::max(nextSequence, record.sequence + 1);
+        records.push_back(std::move(record));
+        ++logRecordCount;
+    }
+    file.close();
+
+    // Оборванный хвост журнала: целые записи перенесет в снимок поток записи
+    // до первой дозаписи (иначе новые записи легли бы за поврежденные байты)
+    if (damagedTail) compactRequested = true;
+}
+
+void LeaderboardStore::writerLoop()
+{
+    AllocationTracker::Scope other(AllocationTracker::Subsystem::Other);
+    if (compactRequested) compactRequested = !compact();
+
+    for (;;)
+    {
+        LeaderboardRecord record;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            wakeUp.wait(lock, [this]() { return stopRequested || !queue.empty(); });
+            if (queue.empty()) return; // остановка после записи всей очереди
+            record = std::move(queue.front());
+            queue.pop_front();
+        }
+
+        // Журнал все еще поврежден (прошлое сжатие не удалось) - сначала снимок
+        if (compactRequested) compactRequested = !compact();
+
+        record.sequence = nextSequence++;
+        records.push_back(record);
+        if (appendToLog(record))
+        {
+            ++logRecordCount;
+        }
+        else
+        {
+            std::fprintf(stderr, "Leaderboard: failed to append record %llu to %s, saving with snapshot\n",
+                static_cast<unsigned long long>(record.sequence), logPath.c_str());
+            compactRequested = true;
+        }
+
+        if (compactRequested || logRecordCount >= COMPACT_THRESHOLD) compactRequested = !compact();
+    }
+}
+
+bool LeaderboardStore::appendToLog(const LeaderboardRecord& record)
+{
+    for (int attempt = 0; attempt < LOG_WRITE_ATTEMPTS; ++attempt)
+    {
+        if (writeToLog(record)) return true;
+
+        // Неудачная попытка могла оставить в журнале обрывок записи:
+        // после нее журнал заменяется снимком
+        compactRequested = true;
+        std::this_thread::sleep_for(std::chrono::milliseconds(LOG_RETRY_DELAY_MS));
+    }
+    return false;
+}
+
+bool LeaderboardStore::writeToLog(const LeaderboardRecord& record)
+{
+    std::vector<unsigned char> bytes;
+    bytes.reserve(LOG_RECORD_FIXED_SIZE + record.name.size() + 4);
+    put<std::uint32_t>(bytes, LOG_MAGIC);
+    put<std::uint64_t>(bytes, record.sequence);
+    put<std::int32_t>(bytes, record.score);
+    put<std::int64_t>(bytes, record.timestamp);
+    put<std::uint8_t>(bytes, static_cast<std::uint8_t>(record.name.size()));
+    bytes.insert(bytes.end(), record.name.begin(), record.name.end());
+    put<std::uint32_t>(bytes, Checksum::crc32(bytes.data(), bytes.size()));
+
+    std::FILE* file = std::fopen(logPath.c_str(), "ab");
+    if (!file) return false;
+    const bool ok = std::fwrite(bytes.data(), 1, bytes.size(), file) == bytes.size() && syncFile(file);
+    std::fclose(file);
+    return ok;
+}
+
+bool LeaderboardStore::compact()
+{
+    std::stable_sort(records.begin(), records.end(), byScoreDesc);
+
+    std::vector<unsigned char> payload;
+    payload.reserve(records.size() * SNAPSHOT_RECORD_SIZE);
+    for (const auto& record : records)
+    {
+        put<std::int32_t>(payload, record.score);
+        put<std::uint32_t>(payload, 0);
+        put<std::int64_t>(payload, record.timestamp);
+        char name[SNAPSHOT_NAME_SIZE] = {};
+        std::memcpy(name, record.name.data(), std::min(record.name.size(), SNAPSHOT_NAME_SIZE - 1));
+        payload.insert(payload.end(), name, name + SNAPSHOT_NAME_SIZE);
+    }
+
+    std::vector<unsigned char> header;
+    put<std::uint32_t>(header, SNAPSHOT_MAGIC);
+    put<std::uint32_t>(header, SNAPSHOT_VERSION);
+    put<std::uint32_t>(header, static_cast<std::uint32_t>(records.size()));
+    put<std::uint32_t>(header, Checksum::crc32(payload.data(), payload.size()));
+    put<std::uint64_t>(header, nextSequence - 1);
+
+    const std::string tempPath = snapshotPath + ".tmp";
+    std::FILE* file = std::fopen(tempPath.c_str(), "wb");
+    if (!file) return false;
+    bool ok = std::fwrite(header.data(), 1, header.size(), file) == header.size()
+        && std::fwrite(payload.data(), 1, payload.size(), file) == payload.size()
+        && syncFile(file);
+    std::fclose(file);
+
+    if (!ok || !replaceFile(tempPath, snapshotPath))
+    {
+        std::remove(tempPath.c_str());
+        return false;
+    }
+
+    // Снимок на диске: журнал можно очистить
+    file = std::fopen(logPath.c_str(), "wb");
+    if (file)
+    {
+        syncFile(file);
+        std::fclose(file);
+    }
+    logRecordCount = 0;
+    return true;
+}
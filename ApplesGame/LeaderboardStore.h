@@ -0,0 +1,73 @@
+﻿/*
+Постоянное хранилище таблицы рекордов.
+
+- leaderboard.log: журнал только на дозапись. Каждая запись содержит номер,
+  очки, время, имя и CRC32; оборванная при сбое питания запись в конце
+  журнала отбрасывается при загрузке.
+- leaderboard.dat: отсортированный снимок записей фиксированного размера,
+  читается через отображение в память (MappedFile).
+- Запись на диск и периодическое сжатие журнала в снимок выполняются
+  фоновым потоком; append() не блокирует поток рендера.
+- Сжатие оборванного журнала, найденного при загрузке, - тоже в фоновом
+  потоке, первым делом до новых записей.
+- Неудачная дозапись повторяется; если журнал так и не записан, запись
+  остается в памяти и сохраняется следующим снимком (сжатие сразу).
+- Снимок заменяется атомарно (временный файл + rename), номер последней
+  вошедшей в него записи защищает от повторов после сбоя.
+*/
+
+#pragma once
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+struct LeaderboardRecord
+{
+    std::string name;
+    int score = 0;
+    std::int64_t timestamp = 0;
+    std::uint64_t sequence = 0;
+};
+
+class LeaderboardStore
+{
+public:
+    LeaderboardStore(const std::string& logPath, const std::string& snapshotPath);
+    ~LeaderboardStore();
+    LeaderboardStore(const LeaderboardStore&) = delete;
+    LeaderboardStore& operator=(const LeaderboardStore&) = delete;
+
+    // Читает снимок и журнал, запускает фоновый поток записи.
+    // Возвращает все записи по убыванию очков.
+    std::vector<LeaderboardRecord> load();
+
+    // Ставит запись в очередь на сохранение (не блокирует)
+    void append(const std::string& name, int score);
+
+private:
+    std::string logPath;
+    std::string snapshotPath;
+
+    // Данные фонового потока
+    std::vector<LeaderboardRecord> records;
+    std::uint64_t nextSequence = 1;
+    int logRecordCount = 0;
+
+    std::deque<LeaderboardRecord> queue;
+    std::mutex mutex;
+    std::condition_variable wakeUp;
+    std::thread worker;
+    bool stopRequested = false;
+    bool compactRequested = false; // снимок до порога: оборванный журнал или неудачная дозапись
+
+    void loadSnapshot(std::uint64_t& lastSequence);
+    void loadLog(std::uint64_t lastSequence);
+    void writerLoop();
+    bool writeToLog(const LeaderboardRecord& record);
+    bool appendToLog(const LeaderboardRecord& record); // с повторами
+    bool compact();
+};
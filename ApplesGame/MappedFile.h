@@ -0,0 +1,37 @@
+﻿/*
+Файл, отображенный в память только для чтения.
+
+- Windows: CreateFileMapping / MapViewOfFile
+- POSIX: mmap
+- Данные доступны, пока объект открыт; копирования не происходит.
+*/
+
+#pragma once
+#include <cstddef>
+#include <string>
+
+class MappedFile
+{
+public:
+    MappedFile() = default;
+    ~MappedFile();
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    bool open(const std::string& path);
+    void close();
+
+    bool isOpen() const { return data != nullptr; }
+    const unsigned char* getData() const { return data; }
+    std::size_t getSize() const { return size; }
+
+private:
+    const unsigned char* data = nullptr;
+    std::size_t size = 0;
+#ifdef _WIN32
+    void* fileHandle = nullptr;
+    void* mappingHandle = nullptr;
+#else
+    int fileDescriptor = -1;
+#endif
+};
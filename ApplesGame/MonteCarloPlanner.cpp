@@ -0,0 +1,145 @@
+﻿#include <algorithm>
+#include <cmath>
+#include "MonteCarloPlanner.h"
+#include "CollisionSystem.h"
+#include "MovementSystem.h"
+
+namespace
+{
+    const float DELTA_TIME = 1.0f / 60.0f;
+    const int HOLD_TICKS = 6;            // первое направление прогона держится столько тиков
+    const float SURVIVAL_WEIGHT = 10.0f; // прожитый горизонт дороже десяти яблок
+    const float WIN_BONUS = 100.0f;
+    const int POLICY_TICKS = 8;          // случайная политика меняет решение раз в столько тиков
+    const float LOOK_AHEAD = 0.25f;      // с, проверка свободного пути в политике
+
+    Direction opposite(Direction direction)
+    {
+        return static_cast<Direction>((static_cast<int>(direction) + 2) % 4);
+    }
+
+    // Ничего не задеть за LOOK_AHEAD секунд движения в direction
+    bool clearAhead(const SimState& state, Direction direction)
+    {
+        const float radius = Constants::PLAYER_SIZE / 2.0f;
+        const sf::Vector2f from = state.playerPosition;
+        const sf::Vector2f to = from + directionVector(direction) * (state.playerSpeed * LOOK_AHEAD);
+        if (to.x - radius < 1.0f || to.x + radius > Constants::SCREEN_WIDTH - 1.0f
+            || to.y - radius < 1.0f || to.y + radius > Constants::SCREEN_HEIGHT - 1.0f)
+        {
+            return false;
+        }
+
+        float timeOfImpact = 0.0f;
+        for (int i = 0; i < state.obstacleCount; ++i)
+        {
+            if (Collision::sweptCircleRect(from, to, radius, state.obstacles[i].position,
+                state.obstacles[i].size, timeOfImpact))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // К ближайшему яблоку по большей из осей
+    Direction towardNearestApple(const SimState& state, Direction fallback)
+    {
+        float bestDistanceSq = -1.0f;
+        sf::Vector2f best;
+        for (int i = 0; i < state.appleCount; ++i)
+        {
+            const sf::Vector2f delta = state.apples[i] - state.playerPosition;
+            const float distanceSq = delta.x * delta.x + delta.y * delta.y;
+            if (bestDistanceSq < 0.0f || distanceSq < bestDistanceSq)
+            {
+                bestDistanceSq = distanceSq;
+                best = delta;
+            }
+        }
+        if (bestDistanceSq < 0.0f) return fallback;
+        if (std::abs(best.x) > std::abs(best.y)) return best.x > 0.0f ? Direction::Right : Direction::Left;
+        return best.y > 0.0f ? Direction::Down : Direction::Up;
+    }
+
+    // Политика прогона: к яблоку или случайно, но без разворота и не в стену
+    Direction rolloutPolicy(SimState& state, Direction current)
+    {
+        Direction wanted = Sim::randomInt(state, 2) == 0
+            ? towardNearestApple(state, current)
+            : static_cast<Direction>(Sim::randomInt(state, 4));
+        if (wanted != opposite(current) && clearAhead(state, wanted)) return wanted;
+        if (clearAhead(state, current)) return current;
+
+        const int start = Sim::randomInt(state, 4);
+        for (int i = 0; i < 4; ++i)
+        {
+            const Direction direction = static_cast<Direction>((start + i) % 4);
+            if (direction != opposite(current) && clearAhead(state, direction)) return direction;
+        }
+        return current;
+    }
+}
+
+MonteCarloPlanner::MonteCarloPlanner(int rolloutsPerDirection, int horizonTicks, int threadCount)
+    : rolloutsPerDirection(std::max(1, rolloutsPerDirection)),
+    horizonTicks(horizonTicks > HOLD_TICKS ? horizonTicks : HOLD_TICKS),
+    pool(threadCount)
+{
+    results.resize(static_cast<std::size_t>(this->rolloutsPerDirection) * 4);
+}
+
+int MonteCarloPlanner::getHoldTicks() const
+{
+    return HOLD_TICKS;
+}
+
+Direction MonteCarloPlanner::decide(const SimState& state)
+{
+    if (!state.alive || state.won) return state.playerDirection;
+
+    root = state;
+    rolloutTotal = rolloutsPerDirection * 4;
+    decisionSeed = decisionSeed * 1664525u + 1013904223u + static_cast<std::uint32_t>(state.ticks);
+    pool.run(rolloutTotal, &MonteCarloPlanner::rolloutTask, this);
+    rolloutCount += rolloutTotal;
+
+    // Прогон index начинается с направления index % 4
+    float sums[4] = {};
+    for (int i = 0; i < rolloutTotal; ++i) sums[i % 4] += results[i];
+
+    // При равенстве остается текущее направление
+    Direction best = state.playerDirection;
+    for (int i = 0; i < 4; ++i)
+    {
+        if (sums[i] > sums[static_cast<int>(best)]) best = static_cast<Direction>(i);
+    }
+    return best;
+}
+
+void MonteCarloPlanner::rolloutTask(void* context, int index)
+{
+    MonteCarloPlanner& planner = *static_cast<MonteCarloPlanner*>(context);
+    planner.results[index] = planner.rollout(index);
+}
+
+float MonteCarloPlanner::rollout(int index) const
+{
+    SimState sim = root;
+
+    // Свой поток случайности на прогон: будущие респавны яблок и повороты противников тоже разыгрываются
+    sim.random = (decisionSeed ^ (static_cast<std::uint32_t>(index + 1) * 0x9E3779B9u)) | 1u;
+
+    Direction direction = static_cast<Direction>(index % 4);
+    int tick = 0;
+    for (; tick < horizonTicks && sim.alive && !sim.won; ++tick)
+    {
+        if (tick >= HOLD_TICKS && tick % POLICY_TICKS == 0) direction = rolloutPolicy(sim, direction);
+        Sim::step(sim, direction, DELTA_TIME);
+    }
+
+    float value = static_cast<float>(sim.score - root.score);
+    value += SURVIVAL_WEIGHT * (sim.alive ? 1.0f : static_cast<float>(tick) / horizonTicks);
+    if (sim.won) value += WIN_BONUS;
+    return value;
+}
@@ -0,0 +1,51 @@
+﻿/*
+Планирующий бот: Monte Carlo прогоны по клонам SimState.
+
+- На каждое решение корневое состояние копируется для каждого прогона
+  (копия SimState - memcpy), прогон держит первое направление
+  getHoldTicks() тиков, затем играет случайной политикой до горизонта.
+- Направление выбирается по среднему результату его прогонов: очки,
+  набранные за горизонт, плюс доля прожитого горизонта (смерть дорога).
+- Прогоны считаются в WorkerPool вместе с вызывающим потоком; результаты
+  пишутся в слоты по индексу прогона, поэтому решение не зависит от
+  числа потоков.
+- Используется для оценки теоретического максимума очков на seed при
+  настройке сложности (ApplesGame --plan).
+*/
+
+#pragma once
+#include <cstdint>
+#include <vector>
+#include "SimState.h"
+#include "WorkerPool.h"
+
+class MonteCarloPlanner
+{
+public:
+    // threadCount = 0 - по числу ядер
+    MonteCarloPlanner(int rolloutsPerDirection, int horizonTicks, int threadCount = 0);
+    // Лучшее направление из state; state не меняется
+    Direction decide(const SimState& state);
+
+    long long getRolloutCount() const { return rolloutCount; }
+    int getThreadCount() const { return pool.getThreadCount(); }
+
+    // Решение рассчитано на столько тиков: чаще вызывать decide() незачем
+    int getHoldTicks() const;
+
+private:
+    const int rolloutsPerDirection;
+    const int horizonTicks;
+
+    // Задание текущего решения
+    SimState root;
+    int rolloutTotal = 0;
+    std::uint32_t decisionSeed = 1;
+    std::vector<float> results;
+    long long rolloutCount = 0;
+
+    WorkerPool pool;
+
+    static void rolloutTask(void* context, int index);
+    float rollout(int index) const;
+};
@@ -0,0 +1,36 @@
+﻿#include <cmath>
+#include "MovementSystem.h"
+#include "Player.h"
+#include "Enemy.h"
+
+namespace
+{
+    // Порядок совпадает с enum class Direction { Right, Up, Left, Down }
+    const float DIRECTION_X[4] = { 1.0f, 0.0f, -1.0f, 0.0f };
+    const float DIRECTION_Y[4] = { 0.0f, -1.0f, 0.0f, 1.0f };
+}
+
+sf::Vector2f directionVector(Direction direction)
+{
+    const int index = static_cast<int>(direction);
+    return sf::Vector2f(DIRECTION_X[index], DIRECTION_Y[index]);
+}
+
+float rotationFor(const sf::Vector2f& velocity)
+{
+    return std::atan2(velocity.y, velocity.x) * 180.0f / 3.14159265f;
+}
+
+void MovementSystem::step(float deltaTime, Player& player, SlotMap<Enemy>& enemies)
+{
+    player.previousPosition = player.position;
+    player.position += player.velocity * deltaTime;
+
+    // Плотный массив SlotMap: проход по подряд лежащим объектам
+    for (std::size_t i = 0; i < enemies.size(); ++i)
+    {
+        Enemy& enemy = enemies[i];
+        enemy.previousPosition = enemy.position;
+        enemy.position += enemy.velocity * deltaTime;
+    }
+}
@@ -0,0 +1,35 @@
+﻿/*
+Перемещение игрока и противников по вектору скорости.
+
+- Объекты только задают velocity (из направления, поля потока или ввода);
+  step() выполняет position += velocity * dt прямо на объектах (противники
+  лежат подряд в плотном массиве SlotMap), запоминая previousPosition для
+  swept-коллизий. Движущихся объектов единицы, копия в отдельные массивы
+  стоила бы дороже самого шага.
+- Direction остается вводом: directionVector() переводит его в единичный
+  вектор по таблице, без switch.
+- Поворот спрайта вычисляется из скорости только при отрисовке
+  (rotationFor), поэтому движение по диагонали и аналоговый ввод не
+  требуют отдельной логики.
+*/
+
+#pragma once
+#include <SFML/System/Vector2.hpp>
+#include "Enums.h"
+#include "SlotMap.h"
+
+class Player;
+class Enemy;
+
+// Единичный вектор направления (ось y экрана направлена вниз)
+sf::Vector2f directionVector(Direction direction);
+
+// Угол поворота спрайта в градусах для ненулевой скорости
+float rotationFor(const sf::Vector2f& velocity);
+
+class MovementSystem
+{
+public:
+    // Перемещает игрока и всех противников за шаг
+    void step(float deltaTime, Player& player, SlotMap<Enemy>& enemies);
+};
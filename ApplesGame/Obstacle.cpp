@@ -28,7 +28,7 @@ Obstacle::Obstacle(float width, float height)
     shape.setFillColor(sf::Color::Yellow);
 }
 
-void Obstacle::draw(sf::RenderWindow& window) 
+void Obstacle::draw(CountingRenderTarget& window) 
 {
     shape.setPosition(position);
     window.draw(shape);
@@ -44,6 +44,11 @@ sf::Vector2f Obstacle::getSize() const
     return shape.getSize();
 }
 
+void Obstacle::setSize(const sf::Vector2f& size) 
+{
+    shape.setSize(size);
+}
+
 void Obstacle::setColor(const sf::Color& color) 
 {
     shape.setFillColor(color);
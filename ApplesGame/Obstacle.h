@@ -38,9 +38,10 @@ public:
     sf::RectangleShape shape;
     sf::FloatRect getBounds() const override;
     sf::Vector2f getSize() const;
+    void setSize(const sf::Vector2f& size);
     sf::Color getColor() const;
 
     Obstacle(float width, float height);
-    void draw(sf::RenderWindow& window) override;
+    void draw(CountingRenderTarget& window) override;
     void setColor(const sf::Color& color); 
 };
\ No newline at end of file
@@ -0,0 +1,138 @@
+﻿#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include "OccupancyRaster.h"
+#include "Constants.h"
+
+namespace
+{
+    const std::uint8_t OCCUPIED = 255;
+}
+
+OccupancyRaster::OccupancyRaster(int width, int height)
+    : width(std::max(1, width)), height(std::max(1, height))
+{
+    cells.resize(static_cast<std::size_t>(CHANNEL_COUNT) * this->width * this->height);
+    setFullView();
+}
+
+void OccupancyRaster::setFullView()
+{
+    setView(sf::Vector2f(Constants::SCREEN_WIDTH / 2.0f, Constants::SCREEN_HEIGHT / 2.0f),
+        sf::Vector2f(static_cast<float>(Constants::SCREEN_WIDTH), static_cast<float>(Constants::SCREEN_HEIGHT)));
+}
+
+void OccupancyRaster::setView(const sf::Vector2f& center, const sf::Vector2f& size)
+{
+    origin = center - size / 2.0f;
+    cellSize = sf::Vector2f(size.x / width, size.y / height);
+}
+
+int OccupancyRaster::columnFor(float x) const
+{
+    const float column = std::ceil((x - origin.x) / cellSize.x - 0.5f);
+    return static_cast<int>(std::min(std::max(column, 0.0f), static_cast<float>(width)));
+}
+
+int OccupancyRaster::rowFor(float y) const
+{
+    const float row = std::ceil((y - origin.y) / cellSize.y - 0.5f);
+    return static_cast<int>(std::min(std::max(row, 0.0f), static_cast<float>(height)));
+}
+
+// Колонки [from, to) строки row
+void OccupancyRaster::fillSpan(Channel channel, int row, int from, int to)
+{
+    if (from >= to) return;
+    std::memset(&cells[(static_cast<std::size_t>(channel) * height + row) * width + from], OCCUPIED,
+        static_cast<std::size_t>(to - from));
+}
+
+void OccupancyRaster::clear()
+{
+    std::fill(cells.begin(), cells.end(), 0);
+
+    // За краем экрана - как препятствие
+    const sf::Vector2f viewMax = origin + sf::Vector2f(cellSize.x * width, cellSize.y * height);
+    const float screenWidth = static_cast<float>(Constants::SCREEN_WIDTH);
+    const float screenHeight = static_cast<float>(Constants::SCREEN_HEIGHT);
+    if (origin.x < 0.0f) fillRect(OBSTACLES, origin, sf::Vector2f(0.0f, viewMax.y));
+    if (viewMax.x > screenWidth) fillRect(OBSTACLES, sf::Vector2f(screenWidth, origin.y), viewMax);
+    if (origin.y < 0.0f) fillRect(OBSTACLES, origin, sf::Vector2f(viewMax.x, 0.0f));
+    if (viewMax.y > screenHeight) fillRect(OBSTACLES, sf::Vector2f(origin.x, screenHeight), viewMax);
+}
+
+void OccupancyRaster::fillRect(Channel channel, const sf::Vector2f& min, const sf::Vector2f& max)
+{
+    const int fromColumn = columnFor(min.x);
+    const int toColumn = columnFor(max.x);
+    const int fromRow = rowFor(min.y);
+    const int toRow = rowFor(max.y);
+
+    if (fromColumn < toColumn && fromRow < toRow)
+    {
+        for (int row = fromRow; row < toRow; ++row) fillSpan(channel, row, fromColumn, toColumn);
+        return;
+    }
+
+    // Уже клетки: хотя бы клетка центра
+    const sf::Vector2f center = (min + max) / 2.0f;
+    const int column = static_cast<int>(std::floor((center.x - origin.x) / cellSize.x));
+    const int row = static_cast<int>(std::floor((center.y - origin.y) / cellSize.y));
+    if (column >= 0 && column < width && row >= 0 && row < height) fillSpan(channel, row, column, column + 1);
+}
+
+void OccupancyRaster::stampDisc(Channel channel, const sf::Vector2f& center, float radius)
+{
+    const int fromRow = rowFor(center.y - radius);
+    const int toRow = rowFor(center.y + radius);
+    const float radiusSq = radius * radius;
+    for (int row = fromRow; row < toRow; ++row)
+    {
+        const float dy = origin.y + (row + 0.5f) * cellSize.y - center.y;
+        const float halfWidthSq = radiusSq - dy * dy;
+        if (halfWidthSq < 0.0f) continue;
+
+        const float halfWidth = std::sqrt(halfWidthSq);
+        fillSpan(channel, row, columnFor(center.x - halfWidth), columnFor(center.x + halfWidth));
+    }
+
+    // Круг меньше клетки может не накрыть ни одного центра
+    const int column = static_cast<int>(std::floor((center.x - origin.x) / cellSize.x));
+    const int row = static_cast<int>(std::floor((center.y - origin.y) / cellSize.y));
+    if (column >= 0 && column < width && row >= 0 && row < height) fillSpan(channel, row, column, column + 1);
+}
+
+void OccupancyRaster::rasterize(const SimState& state)
+{
+    clear();
+    for (int i = 0; i < state.obstacleCount; ++i)
+    {
+        const SimState::Rect& obstacle = state.obstacles[i];
+        fillRect(OBSTACLES, obstacle.position, obstacle.position + obstacle.size);
+    }
+    for (int i = 0; i < state.appleCount; ++i) stampDisc(APPLES, state.apples[i], Constants::APPLE_SIZE / 2.0f);
+    for (int i = 0; i < state.enemyCount; ++i)
+    {
+        stampDisc(ENEMIES, state.enemies[i].position, Constants::PLAYER_SIZE / 2.0f);
+    }
+    stampDisc(PLAYER, state.playerPosition, Constants::PLAYER_SIZE / 2.0f);
+}
+
+bool OccupancyRaster::writePgm(const std::string& path) const
+{
+    std::FILE* file = std::fopen(path.c_str(), "wb");
+    if (!file) return false;
+
+    bool ok = std::fprintf(file, "P5\n%d %d\n255\n", width * CHANNEL_COUNT, height) > 0;
+    for (int row = 0; ok && row < height; ++row)
+    {
+        for (int channel = 0; ok && channel < CHANNEL_COUNT; ++channel)
+        {
+            const std::uint8_t* line = getChannel(static_cast<Channel>(channel)) + row * width;
+            ok = std::fwrite(line, 1, width, file) == static_cast<std::size_t>(width);
+        }
+    }
+    return std::fclose(file) == 0 && ok;
+}
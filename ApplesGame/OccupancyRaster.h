@@ -0,0 +1,63 @@
+﻿/*
+Растр занятости мира на CPU: несколько маленьких каналов uint8 (0 или 255)
+без окна и GL-контекста - для анализа без отрисовки и наблюдений агентов.
+
+- Каналы: игрок, яблоки, препятствия, противники, бонусное яблоко.
+- Область: весь экран (setFullView) или окно вокруг точки (setView),
+  например вокруг игрока; часть окна за краем экрана отмечается в канале
+  препятствий - край так же смертелен.
+- Клетка занята, если ее центр внутри объекта; объект меньше клетки
+  отмечает хотя бы клетку своего центра.
+- Прямоугольник заливается построчно, круг - штампом из горизонтальных
+  отрезков (полуширина строки из уравнения круга); отрезок - один
+  memset, так что заливка сводится к плотной записи строк.
+- Каналы лежат плоско друг за другом: getChannel(c)[y * width + x].
+- Заголовок знает только SimState - его можно включать без игровых
+  объектов (VecEnv, C-интерфейс); растр живой партии - в GameRaster.h.
+*/
+
+#pragma once
+#include <SFML/Graphics.hpp>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "SimState.h"
+
+class OccupancyRaster
+{
+public:
+    enum Channel { PLAYER, APPLES, OBSTACLES, ENEMIES, BONUS, CHANNEL_COUNT };
+
+    explicit OccupancyRaster(int width = 64, int height = 48);
+
+    void setFullView();
+    void setView(const sf::Vector2f& center, const sf::Vector2f& size);
+
+    // Обнуляет каналы; область за краем экрана - в OBSTACLES
+    void clear();
+    void fillRect(Channel channel, const sf::Vector2f& min, const sf::Vector2f& max);
+    void stampDisc(Channel channel, const sf::Vector2f& center, float radius);
+
+    // Весь мир в текущей области (с clear())
+    void rasterize(const SimState& state);
+
+    // Каналы рядом слева направо, оттенки серого (PGM); false - файл не записан
+    bool writePgm(const std::string& path) const;
+
+    int getWidth() const { return width; }
+    int getHeight() const { return height; }
+    const std::uint8_t* getChannel(Channel channel) const { return &cells[channel * width * height]; }
+    const std::uint8_t* getData() const { return cells.data(); }
+    int getDataSize() const { return static_cast<int>(cells.size()); }
+
+private:
+    int width;
+    int height;
+    sf::Vector2f origin;   // мировая точка левого верхнего угла растра
+    sf::Vector2f cellSize; // мировой размер клетки
+    std::vector<std::uint8_t> cells;
+
+    int columnFor(float x) const; // первая колонка с центром не левее x
+    int rowFor(float y) const;
+    void fillSpan(Channel channel, int row, int from, int to);
+};
@@ -15,45 +15,39 @@ ______ _      _____   _____________
 
 Player::Player() 
 {
-    //  
-    if (!texture.loadFromFile(Constants::RESOURCES_PATH + "player.png"))
-    {
-        throw std::runtime_error("Failed to load player texture!");
-    }
-    sprite.setTexture(texture);
+    baseColor = sf::Color::Cyan;
+    reset();
+}
+
+//     
+void Player::setTexture(const sf::Texture& texture)
+{
+    sprite.setTexture(texture, true);
 
     //    
     float scale = Constants::PLAYER_SIZE / texture.getSize().x * 1.2f;
     sprite.setScale(scale, scale);
     sprite.setOrigin(texture.getSize().x / 2, texture.getSize().y / 2);
-    baseColor = sf::Color::Cyan;
-    updateRotation();
-    reset();
 }
 
 //  
 void Player::reset() 
 {
     position = { Constants::SCREEN_WIDTH / 2.f, Constants::SCREEN_HEIGHT / 2.f };
+    previousPosition = position;
     sprite.setPosition(position);
     speed = Constants::INIT_SPEED;
     direction = Direction::Right;
-    updateRotation();
+    velocity = directionVector(direction) * speed;
+    sprite.setRotation(rotationFor(velocity));
     sprite.setColor(sf::Color::Cyan);
     isBlinking = false;
 }
 
-//      
-void Player::update(float deltaTime)
+//    ;   MovementSystem
+void Player::update()
 {
-    switch (direction)
-    {
-    case Direction::Right: position.x += speed * deltaTime; break;
-    case Direction::Up:    position.y -= speed * deltaTime; break;
-    case Direction::Left:  position.x -= speed * deltaTime; break;
-    case Direction::Down:  position.y += speed * deltaTime; break;
-    }
-    updateRotation();
+    velocity = directionVector(direction) * speed;
     //speed += Constants::ACCELERATION * deltaTime;
     updateBlink();
 }
@@ -79,29 +73,10 @@ void Player::updateBlink()
     }
 }
 
-//   
-void Player::updateRotation()
-{
-    switch (direction)
-    {
-        case Direction::Right:
-            sprite.setRotation(0.f);
-            break;
-        case Direction::Up:
-            sprite.setRotation(270.f);
-            break;
-        case Direction::Left:
-            sprite.setRotation(180.f);
-            break;
-        case Direction::Down:
-            sprite.setRotation(90.f);
-            break;
-    }
-}
-
-//  
-void Player::draw(sf::RenderWindow& window)
+//  ;      
+void Player::draw(CountingRenderTarget& window)
 {
+    if (velocity.x != 0.0f || velocity.y != 0.0f) sprite.setRotation(rotationFor(velocity));
     sprite.setPosition(position);
     window.draw(sprite);
 }
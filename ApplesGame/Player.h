@@ -9,14 +9,14 @@ ______ _      _____   _____________
  Player    .
 
  :
--    4- 
+-     ;   MovementSystem
 -      / 
 -   ( )
 
 :
 -  :
-  *   (texture, color)
-  *   (direction, speed)
+  *   (color);    (setTexture)
+  *   (direction, speed, velocity)
   *  (blinkClock)
   *   (isBlinking)
 -  :
@@ -30,16 +30,16 @@ ______ _      _____   _____________
 #include "Constants.h"
 #include "GameObjects.h"
 #include "Enums.h"
+#include "MovementSystem.h"
 
 class Player : public GameObject 
 {
 private:
-    sf::Texture texture;
     sf::Color baseColor;
-    void updateRotation();
 
 public:
     Direction direction;
+    sf::Vector2f velocity; //  (px/s),       draw()
     sf::Sprite sprite;
     sf::Clock blinkClock;
     sf::FloatRect getBounds() const override;
@@ -47,12 +47,14 @@ public:
     bool isBlinking = false;
     float speed;
     float getSpeed() const;
+    sf::Vector2f previousPosition; //     ( swept-)
 
     Player();
+    void setTexture(const sf::Texture& texture);
     void reset();
-    void update(float deltaTime);
+    void update();
     void updateBlink();
-    void draw(sf::RenderWindow& window) override;
+    void draw(CountingRenderTarget& window) override;
     void setColor(const sf::Color& color);
     void increaseSpeed();
     void resetSpeed();
@@ -0,0 +1,201 @@
+﻿#include <algorithm>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+#include "ResourceLoader.h"
+#include "Constants.h"
+#include "AllocationTracker.h"
+
+ResourceLoader::~ResourceLoader()
+{
+    for (auto& worker : workers)
+    {
+        if (worker.joinable()) worker.join();
+    }
+}
+
+void ResourceLoader::add(Kind kind, Group group, const std::string& name)
+{
+    auto task = std::make_unique<Task>();
+    task->kind = kind;
+    task->group = group;
+    task->name = name;
+    tasks.push_back(std::move(task));
+}
+
+void ResourceLoader::addFont(Group group, const std::string& name, sf::Font& target)
+{
+    add(Kind::Font, group, name);
+    tasks.back()->font = &target;
+}
+
+void ResourceLoader::addSound(Group group, const std::string& name, sf::SoundBuffer& target)
+{
+    add(Kind::Sound, group, name);
+    tasks.back()->sound = &target;
+}
+
+void ResourceLoader::addTexture(Group group, const std::string& name, sf::Texture& target)
+{
+    add(Kind::Texture, group, name);
+    tasks.back()->texture = &target;
+}
+
+void ResourceLoader::addStream(Group group, const std::string& name)
+{
+    add(Kind::Stream, group, name);
+}
+
+void ResourceLoader::setPack(const ResourcePack* resourcePack)
+{
+    pack = resourcePack;
+}
+
+void ResourceLoader::start()
+{
+    // Ресурсы меню обрабатываются первыми
+    std::stable_sort(tasks.begin(), tasks.end(),
+        [](const std::unique_ptr<Task>& a, const std::unique_ptr<Task>& b)
+        {
+            return a->group == Group::Menu && b->group != Group::Menu;
+        });
+
+    const unsigned hw = std::max(1u, std::thread::hardware_concurrency());
+    const size_t count = std::min<size_t>(hw, tasks.size());
+    for (size_t i = 0; i < count; ++i)
+    {
+        workers.emplace_back(&ResourceLoader::workerLoop, this);
+    }
+}
+
+void ResourceLoader::workerLoop()
+{
+    AllocationTracker::Scope other(AllocationTracker::Subsystem::Other);
+    for (;;)
+    {
+        const size_t index = nextTask.fetch_add(1);
+        if (index >= tasks.size()) return;
+
+        Task& task = *tasks[index];
+        bool ok = false;
+        try
+        {
+            ok = decode(task);
+        }
+        catch (const std::exception&)
+        {
+            // Поврежденная запись пакета
+            ok = false;
+        }
+        task.status.store(ok ? DECODED : FAILED, std::memory_order_release);
+    }
+}
+
+// Рабочий поток: только чтение и декодирование, без обращения к SFML-ресурсам
+bool ResourceLoader::decode(Task& task) const
+{
+    const std::string path = Constants::RESOURCES_PATH + task.name;
+    const ResourcePack::Blob blob = pack ? pack->find(task.name) : ResourcePack::Blob();
+
+    switch (task.kind)
+    {
+    case Kind::Font:
+    {
+        // Из пакета шрифт читается без копирования
+        if (blob)
+        {
+            task.memory = blob.data;
+            task.memorySize = blob.size;
+            return true;
+        }
+        std::ifstream file(path, std::ios::binary);
+        if (!file) return false;
+        task.bytes.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+        task.memory = task.bytes.data();
+        task.memorySize = task.bytes.size();
+        return !task.bytes.empty();
+    }
+    case Kind::Sound:
+    {
+        sf::InputSoundFile file;
+        const bool opened = blob ? file.openFromMemory(blob.data, blob.size) : file.openFromFile(path);
+        if (!opened) return false;
+        task.samples.resize(static_cast<size_t>(file.getSampleCount()));
+        task.channelCount = file.getChannelCount();
+        task.sampleRate = file.getSampleRate();
+        return file.read(task.samples.data(), task.samples.size()) == task.samples.size();
+    }
+    case Kind::Texture:
+        return blob ? task.image.loadFromMemory(blob.data, blob.size) : task.image.loadFromFile(path);
+    case Kind::Stream:
+        // find() уже проверил CRC записи; без пакета - только наличие файла
+        return blob || std::ifstream(path, std::ios::binary).good();
+    }
+    return false;
+}
+
+// Главный поток: загрузка в целевые объекты
+void ResourceLoader::upload(Task& task)
+{
+    switch (task.kind)
+    {
+    case Kind::Font:
+        if (!task.font->loadFromMemory(task.memory, task.memorySize))
+            throw std::runtime_error("Failed to load font.");
+        break;
+    case Kind::Sound:
+        if (!task.sound->loadFromSamples(task.samples.data(), task.samples.size(),
+            task.channelCount, task.sampleRate))
+            throw std::runtime_error("Failed to load sound: " + task.name);
+        // Сэмплы скопированы в буфер OpenAL
+        std::vector<sf::Int16>().swap(task.samples);
+        break;
+    case Kind::Texture:
+        if (!task.texture->loadFromImage(task.image))
+            throw std::runtime_error("Failed to load texture: " + task.name);
+        task.image = sf::Image();
+        break;
+    case Kind::Stream:
+        break;
+    }
+}
+
+void ResourceLoader::poll()
+{
+    for (auto& task : tasks)
+    {
+        const int status = task->status.load(std::memory_order_acquire);
+        if (status == FAILED)
+        {
+            throw std::runtime_error(task->kind == Kind::Font
+                ? std::string("Failed to load font.")
+                : "Failed to load resource: " + task->name);
+        }
+        if (status == DECODED)
+        {
+            upload(*task);
+            task->status.store(DONE, std::memory_order_relaxed);
+            ++doneCount;
+        }
+    }
+}
+
+bool ResourceLoader::isReady(Group group) const
+{
+    for (const auto& task : tasks)
+    {
+        if (task->group == group && task->status.load(std::memory_order_relaxed) != DONE)
+            return false;
+    }
+    return true;
+}
+
+bool ResourceLoader::isFinished() const
+{
+    return doneCount == tasks.size();
+}
+
+float ResourceLoader::getProgress() const
+{
+    return tasks.empty() ? 1.0f : static_cast<float>(doneCount) / tasks.size();
+}
@@ -0,0 +1,93 @@
+﻿/*
+Асинхронный загрузчик ресурсов.
+
+- Чтение и декодирование файлов (WAV -> сэмплы, PNG -> sf::Image, байты шрифта)
+  выполняется в рабочих потоках.
+- Загрузка в SFML-объекты (sf::SoundBuffer, sf::Texture, sf::Font)
+  выполняется только в главном потоке в poll().
+- Потоковые ресурсы (музыка) открываются главным потоком, но их запись в
+  пакете проверяется (CRC32 всего блоба) заранее в рабочем потоке - addStream.
+- Ресурсы разбиты на группы: меню становится доступным, как только готова
+  группа Menu, не дожидаясь остальных ресурсов.
+- Если задан пакет ресурсов (setPack), данные читаются прямо из его
+  отображения в память; иначе - из файлов в Resources/.
+- Ошибки загрузки пробрасываются из poll() как std::runtime_error.
+*/
+
+#pragma once
+#include <SFML/Graphics.hpp>
+#include <SFML/Audio.hpp>
+#include <atomic>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+#include "ResourcePack.h"
+
+class ResourceLoader
+{
+public:
+    enum class Group { Menu, Gameplay };
+
+    ResourceLoader() = default;
+    ~ResourceLoader();
+    ResourceLoader(const ResourceLoader&) = delete;
+    ResourceLoader& operator=(const ResourceLoader&) = delete;
+
+    // Регистрация ресурсов (имена относительно Constants::RESOURCES_PATH)
+    void addFont(Group group, const std::string& name, sf::Font& target);
+    void addSound(Group group, const std::string& name, sf::SoundBuffer& target);
+    void addTexture(Group group, const std::string& name, sf::Texture& target);
+
+    // Только проверка: запись пакета (CRC) или наличие файла; открывает вызывающий
+    void addStream(Group group, const std::string& name);
+
+    // Пакет ресурсов (может быть nullptr); задается до start()
+    void setPack(const ResourcePack* resourcePack);
+
+    // Запускает рабочие потоки
+    void start();
+
+    // Главный поток: загружает декодированные ресурсы в целевые объекты
+    void poll();
+
+    bool isReady(Group group) const;
+    bool isFinished() const;
+    float getProgress() const;
+
+private:
+    enum class Kind { Font, Sound, Texture, Stream };
+    enum Status { PENDING, DECODED, FAILED, DONE };
+
+    struct Task
+    {
+        Kind kind;
+        Group group;
+        std::string name;
+        sf::Font* font = nullptr;
+        sf::SoundBuffer* sound = nullptr;
+        sf::Texture* texture = nullptr;
+
+        // Результат декодирования
+        const void* memory = nullptr; // данные шрифта (в пакете или в bytes)
+        std::size_t memorySize = 0;
+        std::vector<char> bytes; // sf::Font читает данные из памяти все время жизни
+        std::vector<sf::Int16> samples;
+        unsigned channelCount = 0;
+        unsigned sampleRate = 0;
+        sf::Image image;
+
+        std::atomic<int> status{ PENDING };
+    };
+
+    const ResourcePack* pack = nullptr;
+    std::vector<std::unique_ptr<Task>> tasks;
+    std::vector<std::thread> workers;
+    std::atomic<size_t> nextTask{ 0 };
+    size_t doneCount = 0;
+
+    void add(Kind kind, Group group, const std::string& name);
+    void workerLoop();
+    bool decode(Task& task) const;
+    void upload(Task& task);
+};
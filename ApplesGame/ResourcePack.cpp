@@ -0,0 +1,74 @@
+﻿#include <cstring>
+#include <stdexcept>
+#include "ResourcePack.h"
+
+namespace
+{
+    template <typename T>
+    T readValue(const unsigned char* p)
+    {
+        T value;
+        std::memcpy(&value, p, sizeof(T));
+        return value;
+    }
+}
+
+bool ResourcePack::open(const std::string& path)
+{
+    entries.clear();
+    if (!file.open(path)) return false;
+
+    const unsigned char* base = file.getData();
+    const std::size_t total = file.getSize();
+    auto corrupted = [&path]() { return std::runtime_error("Corrupted resource pack: " + path); };
+
+    if (total < PackFormat::HEADER_SIZE || std::memcmp(base, PackFormat::MAGIC, 4) != 0)
+        throw corrupted();
+    if (readValue<std::uint32_t>(base + 4) != PackFormat::VERSION)
+        throw std::runtime_error("Unsupported resource pack version: " + path);
+
+    const std::uint32_t count = readValue<std::uint32_t>(base + 8);
+    std::size_t cursor = readValue<std::uint32_t>(base + 12);
+
+    entries.reserve(count);
+    for (std::uint32_t i = 0; i < count; ++i)
+    {
+        if (cursor + 22 > total) throw corrupted();
+        Entry entry;
+        entry.offset = readValue<std::uint64_t>(base + cursor);
+        entry.size = readValue<std::uint64_t>(base + cursor + 8);
+        entry.crc = readValue<std::uint32_t>(base + cursor + 16);
+        const std::uint16_t nameLength = readValue<std::uint16_t>(base + cursor + 20);
+        cursor += 22;
+
+        if (cursor + nameLength > total || entry.offset > total || entry.size > total - entry.offset)
+            throw corrupted();
+
+        std::string name(reinterpret_cast<const char*>(base + cursor), nameLength);
+        cursor += nameLength;
+
+        entry.verified.reset(new std::atomic<bool>(false));
+        entries.emplace(std::move(name), std::move(entry));
+    }
+    return true;
+}
+
+ResourcePack::Blob ResourcePack::find(const std::string& name) const
+{
+    Blob blob;
+    auto it = entries.find(name);
+    if (it == entries.end()) return blob;
+
+    const Entry& entry = it->second;
+    blob.data = file.getData() + entry.offset;
+    blob.size = static_cast<std::size_t>(entry.size);
+
+    // Проверка целостности при первом обращении
+    if (!entry.verified->load(std::memory_order_acquire))
+    {
+        if (Checksum::crc32(blob.data, blob.size) != entry.crc)
+            throw std::runtime_error("Corrupted resource in pack: " + name);
+        entry.verified->store(true, std::memory_order_release);
+    }
+    return blob;
+}
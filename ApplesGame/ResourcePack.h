@@ -0,0 +1,63 @@
+﻿/*
+Пакет ресурсов (Resources.pak).
+
+Формат (little-endian):
+- Заголовок: magic "APAK", version, entryCount, indexOffset (uint32)
+- Данные файлов подряд, каждый выровнен на 16 байт
+- Индекс: для каждой записи offset (uint64), size (uint64), crc32 (uint32),
+  nameLength (uint16) и имя в UTF-8 ('/' как разделитель)
+
+Во время работы пакет отображается в память (MappedFile), ресурсы
+читаются через loadFromMemory / openFromMemory без копирования.
+CRC32 записи проверяется при первом обращении к ней.
+Пакет собирается утилитой Tools/ResourcePacker.
+*/
+
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include "MappedFile.h"
+#include "Checksum.h"
+
+namespace PackFormat
+{
+    const char MAGIC[4] = { 'A', 'P', 'A', 'K' };
+    const std::uint32_t VERSION = 1;
+    const std::size_t HEADER_SIZE = 16;
+    const std::size_t DATA_ALIGNMENT = 16;
+}
+
+class ResourcePack
+{
+public:
+    struct Blob
+    {
+        const void* data = nullptr;
+        std::size_t size = 0;
+        explicit operator bool() const { return data != nullptr; }
+    };
+
+    // false, если файла нет; std::runtime_error, если он поврежден
+    bool open(const std::string& path);
+    bool isOpen() const { return file.isOpen(); }
+
+    // Пустой Blob, если записи нет; std::runtime_error при несовпадении CRC.
+    // Потокобезопасно: можно вызывать из потоков загрузчика.
+    Blob find(const std::string& name) const;
+
+private:
+    struct Entry
+    {
+        std::uint64_t offset = 0;
+        std::uint64_t size = 0;
+        std::uint32_t crc = 0;
+        std::unique_ptr<std::atomic<bool>> verified;
+    };
+
+    MappedFile file;
+    std::unordered_map<std::string, Entry> entries;
+};
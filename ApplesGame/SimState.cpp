@@ -0,0 +1,266 @@
+﻿#include <algorithm>
+#include <cmath>
+#include "SimState.h"
+#include "CollisionSystem.h"
+#include "MovementSystem.h"
+
+namespace
+{
+    const float PLAYER_RADIUS = Constants::PLAYER_SIZE / 2.0f;
+    const float APPLE_RADIUS = Constants::APPLE_SIZE / 2.0f;
+    const float ENEMY_SPEED = Constants::INIT_SPEED * 0.8f; // как в Enemy::respawn
+    const float MAX_PLAYER_SPEED = 300.0f;                  // как в Player::increaseSpeed
+    const float NO_IMPACT = 2.0f;                           // больше любого времени контакта
+
+    float randomUnit(SimState& state)
+    {
+        return Sim::randomInt(state, 1 << 24) / static_cast<float>(1 << 24);
+    }
+
+    // Game::randomPosition: вне полосы у краев и безопасной зоны
+    sf::Vector2f randomPosition(SimState& state)
+    {
+        const int safeZone = 60;
+        return
+        {
+            20.0f + safeZone + Sim::randomInt(state, Constants::SCREEN_WIDTH - 40 - safeZone * 2),
+            20.0f + safeZone + Sim::randomInt(state, Constants::SCREEN_HEIGHT - 40 - safeZone * 2)
+        };
+    }
+
+    bool overlapsRect(const sf::Vector2f& center, float radius, const SimState::Rect& rect)
+    {
+        const float closestX = std::max(rect.position.x, std::min(center.x, rect.position.x + rect.size.x));
+        const float closestY = std::max(rect.position.y, std::min(center.y, rect.position.y + rect.size.y));
+        const float dx = center.x - closestX;
+        const float dy = center.y - closestY;
+        return dx * dx + dy * dy < radius * radius;
+    }
+
+    // Game::checkCollision для точки спавна: игрок, яблоки (кроме skip) и препятствия
+    bool blocked(const SimState& state, const sf::Vector2f& position, int skipApple)
+    {
+        const float playerReach = APPLE_RADIUS + PLAYER_RADIUS;
+        const sf::Vector2f toPlayer = position - state.playerPosition;
+        if (toPlayer.x * toPlayer.x + toPlayer.y * toPlayer.y <= playerReach * playerReach) return true;
+
+        for (int i = 0; i < state.appleCount; ++i)
+        {
+            if (i == skipApple) continue;
+            const sf::Vector2f delta = position - state.apples[i];
+            if (delta.x * delta.x + delta.y * delta.y <= Constants::APPLE_SIZE * Constants::APPLE_SIZE) return true;
+        }
+        for (int i = 0; i < state.obstacleCount; ++i)
+        {
+            if (overlapsRect(position, APPLE_RADIUS, state.obstacles[i])) return true;
+        }
+        return false;
+    }
+
+    void respawnApple(SimState& state, int index)
+    {
+        do
+        {
+            state.apples[index] = randomPosition(state);
+        }
+        while (blocked(state, state.apples[index], index));
+    }
+
+    // Enemy::wander / Enemy::chase: скорость противника на этот тик
+    sf::Vector2f enemyVelocity(SimState& state, SimState::Mover& enemy, bool chase, float deltaTime)
+    {
+        if (chase)
+        {
+            const sf::Vector2f delta = state.playerPosition - enemy.position;
+            const float length = std::sqrt(delta.x * delta.x + delta.y * delta.y);
+            return length > 0.001f ? delta * (ENEMY_SPEED / length) : sf::Vector2f();
+        }
+
+        enemy.turnTimer -= deltaTime;
+        if (enemy.turnTimer <= 0.0f)
+        {
+            enemy.direction = static_cast<Direction>(Sim::randomInt(state, 4));
+            enemy.turnTimer = 1.0f + Sim::randomInt(state, 2000) / 1000.0f;
+        }
+        return directionVector(enemy.direction) * ENEMY_SPEED;
+    }
+
+    // Enemy::resolveMove / Enemy::clampToScreen после перемещения
+    void resolveEnemy(SimState& state, SimState::Mover& enemy, bool chase)
+    {
+        const float halfSize = Constants::PLAYER_SIZE / 2.0f;
+        if (!chase)
+        {
+            for (int i = 0; i < state.obstacleCount; ++i)
+            {
+                if (overlapsRect(enemy.position, halfSize, state.obstacles[i]))
+                {
+                    enemy.direction = static_cast<Direction>(Sim::randomInt(state, 4));
+                    break;
+                }
+            }
+
+            const float buffer = 5.0f;
+            if ((enemy.position.x < halfSize + buffer || enemy.position.x > Constants::SCREEN_WIDTH - halfSize - buffer
+                || enemy.position.y < halfSize + buffer || enemy.position.y > Constants::SCREEN_HEIGHT - halfSize - buffer)
+                && randomUnit(state) < Constants::ENEMY_TURN_PROBABILITY)
+            {
+                enemy.direction = static_cast<Direction>(Sim::randomInt(state, 4));
+            }
+        }
+        enemy.position.x = std::min(std::max(enemy.position.x, halfSize), Constants::SCREEN_WIDTH - halfSize);
+        enemy.position.y = std::min(std::max(enemy.position.y, halfSize), Constants::SCREEN_HEIGHT - halfSize);
+    }
+}
+
+int Sim::randomInt(SimState& state, int bound)
+{
+    std::uint32_t x = state.random;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    state.random = x;
+    return static_cast<int>(x % static_cast<std::uint32_t>(bound));
+}
+
+void Sim::generate(SimState& state, int modeMask, std::uint32_t seed)
+{
+    state = SimState();
+    state.random = seed ? seed : 0x9E3779B9u;
+    state.modeMask = modeMask;
+    state.alive = true;
+
+    state.playerPosition = sf::Vector2f(Constants::SCREEN_WIDTH / 2.0f, Constants::SCREEN_HEIGHT / 2.0f);
+    state.playerSpeed = Constants::INIT_SPEED;
+    state.playerDirection = Direction::Right;
+
+    // Препятствия не пересекают игрока и друг друга (Game::spawnObstacles)
+    const float sizeRange = Constants::MAX_OBSTACLE_SIZE - Constants::MIN_OBSTACLE_SIZE;
+    const float playerHalf = Constants::PLAYER_SIZE * 0.6f; // спрайт игрока шире круга коллизии
+    for (int i = 0; i < Constants::NUM_OBSTACLES; ++i)
+    {
+        SimState::Rect& obstacle = state.obstacles[i];
+        bool rejected;
+        do
+        {
+            obstacle.size = sf::Vector2f(Constants::MIN_OBSTACLE_SIZE + randomUnit(state) * sizeRange,
+                Constants::MIN_OBSTACLE_SIZE + randomUnit(state) * sizeRange);
+            obstacle.position = randomPosition(state);
+
+            const sf::FloatRect bounds(obstacle.position, obstacle.size);
+            rejected = bounds.intersects(sf::FloatRect(state.playerPosition.x - playerHalf,
+                state.playerPosition.y - playerHalf, playerHalf * 2.0f, playerHalf * 2.0f));
+            for (int j = 0; j < i && !rejected; ++j)
+            {
+                rejected = overlapsRect(obstacle.position, APPLE_RADIUS, state.obstacles[j]);
+            }
+        }
+        while (rejected);
+        state.obstacleCount = i + 1;
+    }
+
+    // LIMITED_APPLES имеет приоритет, как и в Game::spawnApples
+    state.appleCount = HasGameMode(modeMask, GameMode::LIMITED_APPLES) ? randomInt(state, 6) + 5 : Constants::NUM_APPLES;
+    for (int i = 0; i < state.appleCount; ++i) respawnApple(state, i);
+
+    // В режиме SWARM обычных противников нет, стая не моделируется
+    if (HasGameMode(modeMask, GameMode::SWARM)) return;
+
+    for (int i = 0; i < Constants::NUM_ENEMIES; ++i)
+    {
+        SimState::Mover& enemy = state.enemies[i];
+        enemy.direction = static_cast<Direction>(randomInt(state, 4));
+        enemy.turnTimer = 1.5f + randomInt(state, 2000) / 1000.0f;
+        do
+        {
+            enemy.position = randomPosition(state);
+        }
+        while (blocked(state, enemy.position, -1));
+        state.enemyCount = i + 1;
+    }
+}
+
+void Sim::step(SimState& state, Direction direction, float deltaTime)
+{
+    if (!state.alive || state.won) return;
+
+    const bool limited = HasGameMode(state.modeMask, GameMode::LIMITED_APPLES);
+    const bool unlimited = !limited && HasGameMode(state.modeMask, GameMode::UNLIMITED_APPLES);
+    const bool speedUp = HasGameMode(state.modeMask, GameMode::SPEED_UP);
+    const bool chase = HasGameMode(state.modeMask, GameMode::CHASE);
+
+    ++state.ticks;
+    state.playerDirection = direction;
+    const sf::Vector2f from = state.playerPosition;
+    const sf::Vector2f to = from + directionVector(direction) * (state.playerSpeed * deltaTime);
+
+    // Раньше всего смертельное столкновение: яблоки за ним не засчитываются
+    float fatalTime = NO_IMPACT;
+    bool hitObstacle = false;
+    if (to.x - PLAYER_RADIUS < 1.0f || to.x + PLAYER_RADIUS > Constants::SCREEN_WIDTH - 1.0f
+        || to.y - PLAYER_RADIUS < 1.0f || to.y + PLAYER_RADIUS > Constants::SCREEN_HEIGHT - 1.0f)
+    {
+        fatalTime = 1.0f;
+    }
+    for (int i = 0; i < state.obstacleCount; ++i)
+    {
+        float timeOfImpact = 0.0f;
+        if (Collision::sweptCircleRect(from, to, PLAYER_RADIUS, state.obstacles[i].position,
+            state.obstacles[i].size, timeOfImpact) && timeOfImpact <= fatalTime)
+        {
+            fatalTime = timeOfImpact;
+            hitObstacle = true;
+        }
+    }
+
+    // Противники: скорость, перемещение, реакция; столкновение по относительному движению
+    for (int i = 0; i < state.enemyCount; ++i)
+    {
+        SimState::Mover& enemy = state.enemies[i];
+        const sf::Vector2f enemyFrom = enemy.position;
+        enemy.position += enemyVelocity(state, enemy, chase, deltaTime) * deltaTime;
+        resolveEnemy(state, enemy, chase);
+
+        float timeOfImpact = 0.0f;
+        if (Collision::sweptCircleCircle(from - enemyFrom, to - enemy.position, PLAYER_RADIUS,
+            sf::Vector2f(), PLAYER_RADIUS, timeOfImpact) && timeOfImpact < fatalTime)
+        {
+            fatalTime = timeOfImpact;
+            hitObstacle = false;
+        }
+    }
+
+    for (int i = 0; i < state.appleCount; )
+    {
+        float timeOfImpact = 0.0f;
+        if (!Collision::sweptCircleCircle(from, to, PLAYER_RADIUS, state.apples[i], APPLE_RADIUS, timeOfImpact)
+            || timeOfImpact >= fatalTime)
+        {
+            ++i;
+            continue;
+        }
+
+        ++state.score;
+        if (speedUp) state.playerSpeed = std::min(state.playerSpeed + 15.0f, MAX_PLAYER_SPEED);
+        if (unlimited)
+        {
+            respawnApple(state, i);
+            ++i;
+        }
+        else
+        {
+            state.apples[i] = state.apples[--state.appleCount];
+        }
+    }
+
+    if (fatalTime <= 1.0f)
+    {
+        // Игрок останавливается в точке контакта с препятствием
+        state.playerPosition = hitObstacle ? from + (to - from) * fatalTime : to;
+        state.alive = false;
+        return;
+    }
+
+    state.playerPosition = to;
+    if (limited && state.appleCount == 0) state.won = true;
+}
@@ -0,0 +1,70 @@
+﻿/*
+Упрощенная копия игрового мира для планирования (MonteCarloPlanner).
+
+- SimState - плоская структура фиксированного размера без указателей,
+  текстур и SlotMap: клон состояния - одно копирование памяти (memcpy),
+  поэтому тысячи прогонов в секунду копируют мир без выделений.
+- Sim::step повторяет правила Game::tick: перемещение по скорости,
+  swept-столкновения с краем экрана, препятствиями, противниками и
+  яблоками, ускорение, респавн или удаление яблок, победа в LIMITED_APPLES.
+- Случайность берется из генератора внутри состояния, а не из rand():
+  клоны детерминированы и независимы между потоками.
+- Не моделируются бонусное яблоко и стая SWARM (противников в этом режиме
+  нет); в режиме CHASE противники идут к игроку напрямую, без поля потока.
+*/
+
+#pragma once
+#include <SFML/Graphics.hpp>
+#include <cstdint>
+#include <string>
+#include <type_traits>
+#include "Constants.h"
+#include "Enums.h"
+
+struct SimState
+{
+    struct Rect
+    {
+        sf::Vector2f position; // левый верхний угол
+        sf::Vector2f size;
+    };
+
+    struct Mover
+    {
+        sf::Vector2f position;
+        Direction direction;
+        float turnTimer; // секунд до смены направления
+    };
+
+    sf::Vector2f playerPosition;
+    float playerSpeed;
+    Direction playerDirection;
+
+    sf::Vector2f apples[Constants::NUM_APPLES];
+    Rect obstacles[Constants::NUM_OBSTACLES];
+    Mover enemies[Constants::NUM_ENEMIES];
+    int appleCount;
+    int obstacleCount;
+    int enemyCount;
+
+    int modeMask;
+    int score;
+    int ticks;
+    bool alive;
+    bool won;
+    std::uint32_t random; // состояние генератора (xorshift32), не ноль
+};
+
+static_assert(std::is_trivially_copyable<SimState>::value, "SimState must stay memcpy-able");
+
+namespace Sim
+{
+    // Новая партия по правилам спавна Game (тот же seed - тот же мир)
+    void generate(SimState& state, int modeMask, std::uint32_t seed);
+
+    // Один тик с фиксированным шагом; после смерти или победы ничего не делает
+    void step(SimState& state, Direction direction, float deltaTime);
+
+    // Равномерное случайное из [0, bound) на генераторе состояния
+    int randomInt(SimState& state, int bound);
+}
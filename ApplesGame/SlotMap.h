@@ -0,0 +1,176 @@
+﻿/*
+Контейнер с поколенческими дескрипторами (slot map).
+
+- insert/erase/get за O(1); значения лежат плотно в std::vector,
+  обход без пропусков удаленных элементов.
+- erase переносит последний элемент на место удаленного (swap-remove),
+  дескрипторы остальных элементов при этом остаются действительными.
+- Дескриптор хранит номер поколения слота: после удаления или clear()
+  старый дескриптор не находит элемент, а не указывает на чужой.
+- Удаленные объекты не разрушаются, а остаются в хвосте массива как пул:
+  acquire() отдает такой объект повторно, поэтому перезапуск партии
+  не обращается к куче (SFML-фигуры держат вершины в std::vector).
+*/
+
+#pragma once
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+struct SlotHandle
+{
+    static const std::uint32_t INVALID_INDEX = 0xFFFFFFFFu;
+
+    std::uint32_t index = INVALID_INDEX;
+    std::uint32_t generation = 0;
+
+    bool isValid() const { return index != INVALID_INDEX; }
+    bool operator==(const SlotHandle& other) const { return index == other.index && generation == other.generation; }
+    bool operator!=(const SlotHandle& other) const { return !(*this == other); }
+    bool operator<(const SlotHandle& other) const
+    {
+        return index != other.index ? index < other.index : generation < other.generation;
+    }
+};
+
+template <typename T>
+class SlotMap
+{
+public:
+    using iterator = typename std::vector<T>::iterator;
+    using const_iterator = typename std::vector<T>::const_iterator;
+
+    // Берет объект из пула в том состоянии, в каком он был удален
+    // (вызывающий код инициализирует его заново); новый объект
+    // конструируется из args, только если пул пуст
+    template <typename... Args>
+    SlotHandle acquire(Args&&... args)
+    {
+        if (count == values.size())
+        {
+            values.emplace_back(std::forward<Args>(args)...);
+            denseToSlot.push_back(0);
+        }
+        return attach(count++);
+    }
+
+    SlotHandle insert(const T& value)
+    {
+        if (count < values.size()) values[count] = value;
+        return acquire(value);
+    }
+
+    bool erase(SlotHandle handle)
+    {
+        if (!contains(handle)) return false;
+
+        Slot& slot = slots[handle.index];
+        const std::uint32_t dense = slot.denseIndex;
+        const std::uint32_t last = static_cast<std::uint32_t>(count) - 1;
+
+        // Последний живой элемент копируется на место удаленного (буферы
+        // приемника переиспользуются), его старая копия уходит в пул
+        if (dense != last)
+        {
+            values[dense] = std::move(values[last]);
+            denseToSlot[dense] = denseToSlot[last];
+            slots[denseToSlot[dense]].denseIndex = dense;
+        }
+        --count;
+
+        ++slot.generation;
+        freeSlots.push_back(handle.index);
+        return true;
+    }
+
+    bool contains(SlotHandle handle) const
+    {
+        return handle.index < slots.size() && slots[handle.index].generation == handle.generation;
+    }
+
+    T* get(SlotHandle handle)
+    {
+        return contains(handle) ? &values[slots[handle.index].denseIndex] : nullptr;
+    }
+
+    const T* get(SlotHandle handle) const
+    {
+        return contains(handle) ? &values[slots[handle.index].denseIndex] : nullptr;
+    }
+
+    // Дескриптор элемента по позиции в плотном массиве
+    SlotHandle handleAt(std::size_t denseIndex) const
+    {
+        SlotHandle handle;
+        handle.index = denseToSlot[denseIndex];
+        handle.generation = slots[handle.index].generation;
+        return handle;
+    }
+
+    // Удаляет все элементы в пул; выданные дескрипторы становятся недействительными
+    void clear()
+    {
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            ++slots[denseToSlot[i]].generation;
+            freeSlots.push_back(denseToSlot[i]);
+        }
+        count = 0;
+    }
+
+    void reserve(std::size_t capacity)
+    {
+        values.reserve(capacity);
+        denseToSlot.reserve(capacity);
+        slots.reserve(capacity);
+        freeSlots.reserve(capacity);
+    }
+
+    std::size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+
+    T& operator[](std::size_t denseIndex) { return values[denseIndex]; }
+    const T& operator[](std::size_t denseIndex) const { return values[denseIndex]; }
+
+    iterator begin() { return values.begin(); }
+    iterator end() { return values.begin() + count; }
+    const_iterator begin() const { return values.begin(); }
+    const_iterator end() const { return values.begin() + count; }
+
+private:
+    struct Slot
+    {
+        std::uint32_t denseIndex;
+        std::uint32_t generation;
+    };
+
+    std::vector<T> values;                 // живые значения [0, count), дальше пул
+    std::vector<std::uint32_t> denseToSlot; // слот каждого живого значения
+    std::vector<Slot> slots;
+    std::vector<std::uint32_t> freeSlots;
+    std::size_t count = 0;
+
+    SlotHandle attach(std::size_t denseIndex)
+    {
+        std::uint32_t slotIndex;
+        if (!freeSlots.empty())
+        {
+            slotIndex = freeSlots.back();
+            freeSlots.pop_back();
+        }
+        else
+        {
+            slotIndex = static_cast<std::uint32_t>(slots.size());
+            slots.push_back({ 0, 0 });
+        }
+
+        Slot& slot = slots[slotIndex];
+        slot.denseIndex = static_cast<std::uint32_t>(denseIndex);
+        denseToSlot[denseIndex] = slotIndex;
+
+        SlotHandle handle;
+        handle.index = slotIndex;
+        handle.generation = slot.generation;
+        return handle;
+    }
+};
@@ -0,0 +1,385 @@
+﻿#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <stdexcept>
+#include "SoftwareRenderer.h"
+#include "MovementSystem.h"
+
+namespace
+{
+    const int GLYPH_WIDTH = 5;
+    const int GLYPH_HEIGHT = 7;
+    const int GLYPH_ADVANCE = GLYPH_WIDTH + 1;
+    const char FIRST_GLYPH = ' ';
+    const char LAST_GLYPH = 'Z';
+    const char UNSUPPORTED_GLYPH = '?';
+    const float SCORE_CHARACTER_SIZE = 24.0f;    // как scoreText в Game
+    const float GAME_OVER_CHARACTER_SIZE = 80.0f;
+
+    // Строки глифов 5x7 всех печатных ASCII от ' ' до 'Z', старший из пяти
+    // бит - левая колонка. Строчные буквы рисуются прописными, символы вне
+    // таблицы - знаком UNSUPPORTED_GLYPH (см. addText).
+    const std::uint8_t FONT[LAST_GLYPH - FIRST_GLYPH + 1][GLYPH_HEIGHT] =
+    {
+        { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 }, // ' '
+        { 0x04, 0x04, 0x04, 0x04, 0x04, 0x00, 0x04 }, // '!'
+        { 0x0A, 0x0A, 0x0A, 0x00, 0x00, 0x00, 0x00 }, // '"'
+        { 0x0A, 0x0A, 0x1F, 0x0A, 0x1F, 0x0A, 0x0A }, // '#'
+        { 0x04, 0x0F, 0x14, 0x0E, 0x05, 0x1E, 0x04 }, // '$'
+        { 0x18, 0x19, 0x02, 0x04, 0x08, 0x13, 0x03 }, // '%'
+        { 0x0C, 0x12, 0x14, 0x08, 0x15, 0x12, 0x0D }, // '&'
+        { 0x0C, 0x04, 0x08, 0x00, 0x00, 0x00, 0x00 }, // '\''
+        { 0x02, 0x04, 0x08, 0x08, 0x08, 0x04, 0x02 }, // '('
+        { 0x08, 0x04, 0x02, 0x02, 0x02, 0x04, 0x08 }, // ')'
+        { 0x00, 0x04, 0x15, 0x0E, 0x15, 0x04, 0x00 }, // '*'
+        { 0x00, 0x04, 0x04, 0x1F, 0x04, 0x04, 0x00 }, // '+'
+        { 0x00, 0x00, 0x00, 0x00, 0x0C, 0x04, 0x08 }, // ','
+        { 0x00, 0x00, 0x00, 0x1F, 0x00, 0x00, 0x00 }, // '-'
+        { 0x00, 0x00, 0x00, 0x00, 0x00, 0x0C, 0x0C }, // '.'
+        { 0x00, 0x01, 0x02, 0x04, 0x08, 0x10, 0x00 }, // '/'
+        { 0x0E, 0x11, 0x13, 0x15, 0x19, 0x11, 0x0E }, // '0'
+        { 0x04, 0x0C, 0x04, 0x04, 0x04, 0x04, 0x0E }, // '1'
+        { 0x0E, 0x11, 0x01, 0x02, 0x04, 0x08, 0x1F }, // '2'
+        { 0x1F, 0x02, 0x04, 0x02, 0x01, 0x11, 0x0E }, // '3'
+        { 0x02, 0x06, 0x0A, 0x12, 0x1F, 0x02, 0x02 }, // '4'
+        { 0x1F, 0x10, 0x1E, 0x01, 0x01, 0x11, 0x0E }, // '5'
+        { 0x06, 0x08, 0x10, 0x1E, 0x11, 0x11, 0x0E }, // '6'
+        { 0x1F, 0x01, 0x02, 0x04, 0x08, 0x08, 0x08 }, // '7'
+        { 0x0E, 0x11, 0x11, 0x0E, 0x11, 0x11, 0x0E }, // '8'
+        { 0x0E, 0x11, 0x11, 0x0F, 0x01, 0x02, 0x0C }, // '9'
+        { 0x00, 0x0C, 0x0C, 0x00, 0x0C, 0x0C, 0x00 }, // ':'
+        { 0x00, 0x0C, 0x0C, 0x00, 0x0C, 0x04, 0x08 }, // ';'
+        { 0x02, 0x04, 0x08, 0x10, 0x08, 0x04, 0x02 }, // '<'
+        { 0x00, 0x00, 0x1F, 0x00, 0x1F, 0x00, 0x00 }, // '='
+        { 0x08, 0x04, 0x02, 0x01, 0x02, 0x04, 0x08 }, // '>'
+        { 0x0E, 0x11, 0x01, 0x02, 0x04, 0x00, 0x04 }, // '?'
+        { 0x0E, 0x11, 0x01, 0x0D, 0x15, 0x15, 0x0E }, // '@'
+        { 0x0E, 0x11, 0x11, 0x11, 0x1F, 0x11, 0x11 }, // 'A'
+        { 0x1E, 0x11, 0x11, 0x1E, 0x11, 0x11, 0x1E }, // 'B'
+        { 0x0E, 0x11, 0x10, 0x10, 0x10, 0x11, 0x0E }, // 'C'
+        { 0x1C, 0x12, 0x11, 0x11, 0x11, 0x12, 0x1C }, // 'D'
+        { 0x1F, 0x10, 0x10, 0x1E, 0x10, 0x10, 0x1F }, // 'E'
+        { 0x1F, 0x10, 0x10, 0x1E, 0x10, 0x10, 0x10 }, // 'F'
+        { 0x0E, 0x11, 0x10, 0x17, 0x11, 0x11, 0x0F }, // 'G'
+        { 0x11, 0x11, 0x11, 0x1F, 0x11, 0x11, 0x11 }, // 'H'
+        { 0x0E, 0x04, 0x04, 0x04, 0x04, 0x04, 0x0E }, // 'I'
+        { 0x07, 0x02, 0x02, 0x02, 0x02, 0x12, 0x0C }, // 'J'
+        { 0x11, 0x12, 0x14, 0x18, 0x14, 0x12, 0x11 }, // 'K'
+        { 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x1F }, // 'L'
+        { 0x11, 0x1B, 0x15, 0x15, 0x11, 0x11, 0x11 }, // 'M'
+        { 0x11, 0x11, 0x19, 0x15, 0x13, 0x11, 0x11 }, // 'N'
+        { 0x0E, 0x11, 0x11, 0x11, 0x11, 0x11, 0x0E }, // 'O'
+        { 0x1E, 0x11, 0x11, 0x1E, 0x10, 0x10, 0x10 }, // 'P'
+        { 0x0E, 0x11, 0x11, 0x11, 0x15, 0x12, 0x0D }, // 'Q'
+        { 0x1E, 0x11, 0x11, 0x1E, 0x14, 0x12, 0x11 }, // 'R'
+        { 0x0F, 0x10, 0x10, 0x0E, 0x01, 0x01, 0x1E }, // 'S'
+        { 0x1F, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04 }, // 'T'
+        { 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x0E }, // 'U'
+        { 0x11, 0x11, 0x11, 0x11, 0x11, 0x0A, 0x04 }, // 'V'
+        { 0x11, 0x11, 0x11, 0x15, 0x15, 0x15, 0x0A }, // 'W'
+        { 0x11, 0x11, 0x0A, 0x04, 0x0A, 0x11, 0x11 }, // 'X'
+        { 0x11, 0x11, 0x11, 0x0A, 0x04, 0x04, 0x04 }, // 'Y'
+        { 0x1F, 0x01, 0x02, 0x04, 0x08, 0x10, 0x1F }, // 'Z'
+    };
+
+    // Высота точки шрифта: заглавная 5x7 занимает ~0.7 размера шрифта SFML
+    float dotSizeFor(float characterSize)
+    {
+        return characterSize * 0.7f / GLYPH_HEIGHT;
+    }
+
+    // Символ, который есть в FONT: строчные - прописными, остальное - '?'
+    char glyphFor(char symbol)
+    {
+        if (symbol >= 'a' && symbol <= 'z') return static_cast<char>(symbol - 'a' + 'A');
+        return symbol >= FIRST_GLYPH && symbol <= LAST_GLYPH ? symbol : UNSUPPORTED_GLYPH;
+    }
+
+    // symbol - уже из glyphFor
+    bool glyphDot(char symbol, int column, int row)
+    {
+        return (FONT[symbol - FIRST_GLYPH][row] >> (GLYPH_WIDTH - 1 - column)) & 1;
+    }
+}
+
+SoftwareRenderer::SoftwareRenderer(int width, int height, int threadCount)
+    : width(std::max(1, width)), height(std::max(1, height)),
+    tileColumns((this->width + TILE_SIZE - 1) / TILE_SIZE),
+    tileRows((this->height + TILE_SIZE - 1) / TILE_SIZE),
+    frameScale(static_cast<float>(this->width) / Constants::SCREEN_WIDTH,
+        static_cast<float>(this->height) / Constants::SCREEN_HEIGHT),
+    sizeScale(std::min(frameScale.x, frameScale.y)),
+    pool(threadCount)
+{
+    pixels.resize(static_cast<std::size_t>(this->width) * this->height * 4);
+    primitives.reserve(Constants::NUM_OBSTACLES + Constants::NUM_APPLES + Constants::NUM_ENEMIES + 3);
+}
+
+void SoftwareRenderer::loadSprites(const ResourcePack* pack)
+{
+    const struct { const char* name; sf::Image* image; } sprites[] =
+    {
+        { "player.png", &playerImage },
+        { "enemy.png", &enemyImage },
+    };
+    for (const auto& sprite : sprites)
+    {
+        const ResourcePack::Blob blob = pack ? pack->find(sprite.name) : ResourcePack::Blob();
+        const bool loaded = blob ? sprite.image->loadFromMemory(blob.data, blob.size)
+            : sprite.image->loadFromFile(Constants::RESOURCES_PATH + sprite.name);
+        if (!loaded)
+        {
+            throw std::runtime_error(std::string("Failed to load sprite: ") + sprite.name);
+        }
+    }
+}
+
+void SoftwareRenderer::render(const SimState& state)
+{
+    primitives.clear();
+
+    Primitive rect = {};
+    rect.kind = Primitive::RECT;
+    rect.color = sf::Color::Yellow;
+    for (int i = 0; i < state.obstacleCount; ++i)
+    {
+        rect.min = toFrame(state.obstacles[i].position);
+        rect.max = toFrame(state.obstacles[i].position + state.obstacles[i].size);
+        primitives.push_back(rect);
+    }
+
+    Primitive disc = {};
+    disc.kind = Primitive::DISC;
+    disc.color = sf::Color::Red;
+    disc.radius = Constants::APPLE_SIZE / 2.0f * sizeScale;
+    for (int i = 0; i < state.appleCount; ++i)
+    {
+        disc.center = toFrame(state.apples[i]);
+        disc.min = disc.center - sf::Vector2f(disc.radius, disc.radius);
+        disc.max = disc.center + sf::Vector2f(disc.radius, disc.radius);
+        primitives.push_back(disc);
+    }
+
+    const bool chase = HasGameMode(state.modeMask, GameMode::CHASE);
+    for (int i = 0; i < state.enemyCount; ++i)
+    {
+        const SimState::Mover& enemy = state.enemies[i];
+        sf::Vector2f heading = directionVector(enemy.direction);
+        if (chase)
+        {
+            // Как в Sim::step: преследователь смотрит прямо на игрока
+            const sf::Vector2f toPlayer = state.playerPosition - enemy.position;
+            const float length = std::sqrt(toPlayer.x * toPlayer.x + toPlayer.y * toPlayer.y);
+            if (length > 0.0f) heading = toPlayer / length;
+        }
+        addSprite(enemyImage, enemy.position, heading, sf::Color::White);
+    }
+    addSprite(playerImage, state.playerPosition, directionVector(state.playerDirection), sf::Color::Cyan);
+
+    char text[32];
+    std::snprintf(text, sizeof(text), "Score: %d", state.score);
+    addText(text, toFrame(sf::Vector2f(Constants::SCREEN_WIDTH - 150.0f, 10.0f)),
+        dotSizeFor(SCORE_CHARACTER_SIZE) * sizeScale, sf::Color::White);
+    if (!state.alive)
+    {
+        const char* gameOver = "GAME OVER";
+        const float dotSize = dotSizeFor(GAME_OVER_CHARACTER_SIZE) * sizeScale;
+        const sf::Vector2f size((std::strlen(gameOver) * GLYPH_ADVANCE - 1) * dotSize, GLYPH_HEIGHT * dotSize);
+        const sf::Vector2f center(width / 2.0f, height / 2.0f);
+        addText(gameOver, center - size / 2.0f, dotSize, sf::Color::White);
+    }
+
+    pool.run(tileColumns * tileRows, &SoftwareRenderer::tileTask, this);
+}
+
+bool SoftwareRenderer::saveToFile(const std::string& path) const
+{
+    // sf::Image - только память CPU и кодеки файлов, GL-контекст не нужен
+    sf::Image image;
+    image.create(static_cast<unsigned>(width), static_cast<unsigned>(height), pixels.data());
+    return image.saveToFile(path);
+}
+
+void SoftwareRenderer::addSprite(const sf::Image& image, const sf::Vector2f& center, const sf::Vector2f& heading,
+    sf::Color color)
+{
+    const sf::Vector2u size = image.getSize();
+    Primitive primitive = {};
+    primitive.center = toFrame(center);
+    primitive.color = color;
+    if (size.x == 0 || size.y == 0)
+    {
+        // Спрайты не загружены: круг размером с игрока
+        primitive.kind = Primitive::DISC;
+        primitive.radius = Constants::PLAYER_SIZE / 2.0f * sizeScale;
+    }
+    else
+    {
+        // Масштаб и центр как у спрайтов Player и Enemy
+        primitive.kind = Primitive::SPRITE;
+        primitive.image = &image;
+        primitive.heading = heading;
+        primitive.scale = Constants::PLAYER_SIZE / size.x * 1.2f * sizeScale;
+        primitive.radius = 0.5f * primitive.scale * std::sqrt(static_cast<float>(size.x * size.x + size.y * size.y));
+    }
+    primitive.min = primitive.center - sf::Vector2f(primitive.radius, primitive.radius);
+    primitive.max = primitive.center + sf::Vector2f(primitive.radius, primitive.radius);
+    primitives.push_back(primitive);
+}
+
+sf::Vector2f SoftwareRenderer::toFrame(const sf::Vector2f& point) const
+{
+    return sf::Vector2f(point.x * frameScale.x, point.y * frameScale.y);
+}
+
+// position и pixelSize - уже в пикселях кадра
+void SoftwareRenderer::addText(const char* text, const sf::Vector2f& position, float pixelSize, sf::Color color)
+{
+    Primitive primitive = {};
+    primitive.kind = Primitive::TEXT;
+    primitive.color = color;
+    primitive.scale = pixelSize;
+    int length = 0;
+    for (; text[length] && length < static_cast<int>(sizeof(primitive.text)) - 1; ++length)
+    {
+        primitive.text[length] = glyphFor(text[length]);
+    }
+    primitive.min = position;
+    primitive.max = position + sf::Vector2f(length * GLYPH_ADVANCE * pixelSize, GLYPH_HEIGHT * pixelSize);
+    primitives.push_back(primitive);
+}
+
+void SoftwareRenderer::tileTask(void* context, int tile)
+{
+    static_cast<SoftwareRenderer*>(context)->renderTile(tile);
+}
+
+void SoftwareRenderer::renderTile(int tile)
+{
+    const int left = (tile % tileColumns) * TILE_SIZE;
+    const int top = (tile / tileColumns) * TILE_SIZE;
+    const int right = std::min(left + TILE_SIZE, width);
+    const int bottom = std::min(top + TILE_SIZE, height);
+
+    // Черный фон
+    for (int y = top; y < bottom; ++y)
+    {
+        std::uint8_t* row = &pixels[(static_cast<std::size_t>(y) * width + left) * 4];
+        for (int x = left; x < right; ++x, row += 4)
+        {
+            row[0] = row[1] = row[2] = 0;
+            row[3] = 255;
+        }
+    }
+
+    // Примитивы в порядке добавления (как порядок draw в Game::render)
+    for (const Primitive& primitive : primitives)
+    {
+        // Пиксели, центры которых могут попасть в примитив
+        const int fromX = std::max(left, static_cast<int>(std::floor(primitive.min.x)));
+        const int toX = std::min(right, static_cast<int>(std::ceil(primitive.max.x)));
+        const int fromY = std::max(top, static_cast<int>(std::floor(primitive.min.y)));
+        const int toY = std::min(bottom, static_cast<int>(std::ceil(primitive.max.y)));
+        if (fromX >= toX || fromY >= toY) continue;
+
+        switch (primitive.kind)
+        {
+        case Primitive::RECT: fillRect(primitive, fromX, fromY, toX, toY); break;
+        case Primitive::DISC: fillDisc(primitive, fromX, fromY, toX, toY); break;
+        case Primitive::SPRITE: drawSprite(primitive, fromX, fromY, toX, toY); break;
+        case Primitive::TEXT: drawText(primitive, fromX, fromY, toX, toY); break;
+        }
+    }
+}
+
+void SoftwareRenderer::fillRect(const Primitive& primitive, int left, int top, int right, int bottom)
+{
+    for (int y = top; y < bottom; ++y)
+    {
+        const float centerY = y + 0.5f;
+        if (centerY < primitive.min.y || centerY >= primitive.max.y) continue;
+        for (int x = left; x < right; ++x)
+        {
+            const float centerX = x + 0.5f;
+            if (centerX >= primitive.min.x && centerX < primitive.max.x) blend(x, y, primitive.color);
+        }
+    }
+}
+
+void SoftwareRenderer::fillDisc(const Primitive& primitive, int left, int top, int right, int bottom)
+{
+    const float radiusSq = primitive.radius * primitive.radius;
+    for (int y = top; y < bottom; ++y)
+    {
+        const float dy = y + 0.5f - primitive.center.y;
+        for (int x = left; x < right; ++x)
+        {
+            const float dx = x + 0.5f - primitive.center.x;
+            if (dx * dx + dy * dy <= radiusSq) blend(x, y, primitive.color);
+        }
+    }
+}
+
+void SoftwareRenderer::drawSprite(const Primitive& primitive, int left, int top, int right, int bottom)
+{
+    const sf::Vector2u size = primitive.image->getSize();
+    const std::uint8_t* texels = primitive.image->getPixelsPtr();
+    const float inverseScale = 1.0f / primitive.scale;
+    const float cosine = primitive.heading.x;
+    const float sine = primitive.heading.y;
+
+    for (int y = top; y < bottom; ++y)
+    {
+        const float dy = y + 0.5f - primitive.center.y;
+        for (int x = left; x < right; ++x)
+        {
+            // Обратный поворот пикселя в координаты текстуры (ближайший тексель)
+            const float dx = x + 0.5f - primitive.center.x;
+            const float u = (cosine * dx + sine * dy) * inverseScale + size.x / 2.0f;
+            const float v = (cosine * dy - sine * dx) * inverseScale + size.y / 2.0f;
+            if (u < 0.0f || v < 0.0f) continue;
+            const unsigned column = static_cast<unsigned>(u);
+            const unsigned row = static_cast<unsigned>(v);
+            if (column >= size.x || row >= size.y) continue;
+
+            const std::uint8_t* texel = &texels[(static_cast<std::size_t>(row) * size.x + column) * 4];
+            blend(x, y, sf::Color(
+                static_cast<std::uint8_t>(texel[0] * primitive.color.r / 255),
+                static_cast<std::uint8_t>(texel[1] * primitive.color.g / 255),
+                static_cast<std::uint8_t>(texel[2] * primitive.color.b / 255),
+                static_cast<std::uint8_t>(texel[3] * primitive.color.a / 255)));
+        }
+    }
+}
+
+void SoftwareRenderer::drawText(const Primitive& primitive, int left, int top, int right, int bottom)
+{
+    const float inverseDot = 1.0f / primitive.scale;
+    for (int y = top; y < bottom; ++y)
+    {
+        const int row = static_cast<int>((y + 0.5f - primitive.min.y) * inverseDot);
+        if (row < 0 || row >= GLYPH_HEIGHT) continue;
+        for (int x = left; x < right; ++x)
+        {
+            const float dot = (x + 0.5f - primitive.min.x) * inverseDot;
+            if (dot < 0.0f) continue;
+            const int index = static_cast<int>(dot) / GLYPH_ADVANCE;
+            const int column = static_cast<int>(dot) % GLYPH_ADVANCE;
+            if (index >= static_cast<int>(sizeof(primitive.text)) || !primitive.text[index]) break;
+            if (column < GLYPH_WIDTH && glyphDot(primitive.text[index], column, row)) blend(x, y, primitive.color);
+        }
+    }
+}
+
+void SoftwareRenderer::blend(int x, int y, sf::Color color)
+{
+    if (color.a == 0) return;
+    std::uint8_t* pixel = &pixels[(static_cast<std::size_t>(y) * width + x) * 4];
+    const unsigned alpha = color.a;
+    const unsigned rest = 255 - alpha;
+    pixel[0] = static_cast<std::uint8_t>((color.r * alpha + pixel[0] * rest + 127) / 255);
+    pixel[1] = static_cast<std::uint8_t>((color.g * alpha + pixel[1] * rest + 127) / 255);
+    pixel[2] = static_cast<std::uint8_t>((color.b * alpha + pixel[2] * rest + 127) / 255);
+    pixel[3] = 255;
+}
@@ -0,0 +1,95 @@
+﻿/*
+Программная отрисовка кадра на CPU в буфер RGBA - без окна, OpenGL и
+sf::Texture: миниатюры повторов, кадры нарезок и эталонные изображения
+для сравнения в тестах отрисовки.
+
+- Рисует SimState по тем же правилам, что и Game: черный фон, препятствия
+  желтыми прямоугольниками, яблоки красными кругами, игрок и противники -
+  спрайты из PNG (декодируются в sf::Image, без GL), повернутые по курсу;
+  игрок окрашен в голубой; счет "Score: N" в правом верхнем углу.
+- Мир (экран SCREEN_WIDTH x SCREEN_HEIGHT) растягивается на весь кадр:
+  координаты масштабируются по осям, радиусы, спрайты и текст - по
+  меньшему из двух масштабов, чтобы не искажаться.
+- Текст - встроенный растровый шрифт 5x7 (печатные ASCII от пробела до
+  'Z', строчные - прописными, прочие символы - '?'), увеличенный до
+  высоты шрифта HUD; системный шрифт не нужен.
+- Кадр делится на плитки TILE_SIZE x TILE_SIZE, плитки считаются в
+  WorkerPool: каждая проходит список примитивов кадра и рисует только
+  пересекающие ее. Плитки не перекрываются - потокам не нужна
+  синхронизация, результат не зависит от числа потоков.
+- Список примитивов собирается заново в каждом render(), память под него
+  выделена в конструкторе.
+*/
+
+#pragma once
+#include <SFML/Graphics.hpp>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "ResourcePack.h"
+#include "SimState.h"
+#include "WorkerPool.h"
+
+class SoftwareRenderer
+{
+public:
+    static const int TILE_SIZE = 64;
+
+    // threadCount - всего потоков вместе с вызывающим; 0 - по числу ядер
+    SoftwareRenderer(int width = Constants::SCREEN_WIDTH, int height = Constants::SCREEN_HEIGHT, int threadCount = 0);
+
+    // Спрайты игрока и противника из пакета (если есть) или из RESOURCES_PATH;
+    // std::runtime_error, если PNG не прочитан. Без спрайтов - круги.
+    void loadSprites(const ResourcePack* pack);
+
+    // Кадр мира во весь размер кадра
+    void render(const SimState& state);
+
+    // Сохраняет кадр (формат по расширению: png, bmp, tga, jpg)
+    bool saveToFile(const std::string& path) const;
+
+    int getWidth() const { return width; }
+    int getHeight() const { return height; }
+    int getThreadCount() const { return pool.getThreadCount(); }
+    const std::uint8_t* getPixels() const { return pixels.data(); } // width * height * 4, RGBA
+
+private:
+    struct Primitive
+    {
+        enum Kind { RECT, DISC, SPRITE, TEXT } kind;
+        sf::Vector2f min; // ограничивающий прямоугольник в пикселях кадра
+        sf::Vector2f max;
+        sf::Vector2f center;
+        float radius;           // DISC
+        sf::Vector2f heading;   // SPRITE: единичный курс (cos, sin поворота)
+        float scale;            // SPRITE: пикселей кадра на тексель; TEXT: на точку шрифта
+        const sf::Image* image; // SPRITE
+        sf::Color color;        // заливка или окраска спрайта
+        char text[32];          // TEXT
+    };
+
+    const int width;
+    const int height;
+    const int tileColumns;
+    const int tileRows;
+    const sf::Vector2f frameScale; // пикселей кадра на мировую единицу по осям
+    const float sizeScale;         // для размеров: меньший из frameScale
+
+    std::vector<std::uint8_t> pixels;
+    std::vector<Primitive> primitives;
+    sf::Image playerImage;
+    sf::Image enemyImage;
+    WorkerPool pool;
+
+    sf::Vector2f toFrame(const sf::Vector2f& point) const;
+    void addSprite(const sf::Image& image, const sf::Vector2f& center, const sf::Vector2f& heading, sf::Color color);
+    void addText(const char* text, const sf::Vector2f& position, float pixelSize, sf::Color color);
+
+    static void tileTask(void* context, int tile);
+    void renderTile(int tile);
+    void fillRect(const Primitive& primitive, int left, int top, int right, int bottom);
+    void fillDisc(const Primitive& primitive, int left, int top, int right, int bottom);
+    void drawSprite(const Primitive& primitive, int left, int top, int right, int bottom);
+    void drawText(const Primitive& primitive, int left, int top, int right, int bottom);
+    void blend(int x, int y, sf::Color color);
+};
@@ -1,19 +1,27 @@
 #include "SpatialGrid.h"
 #include "Apple.h"
+#include "Enemy.h"
+#include "Obstacle.h"
 #include "Constants.h"
 #include <algorithm>
+#include <cmath>
 
 void SpatialGrid::init(int screenWidth, int screenHeight, int cellSize) 
 {
     cellSize_ = cellSize > 0 ? cellSize : 128;
     cols_ = (screenWidth + cellSize_ - 1) / cellSize_;
     rows_ = (screenHeight + cellSize_ - 1) / cellSize_;
-    cells_.clear();
+    cells_.assign(static_cast<std::size_t>(cols_) * rows_, std::vector<SlotHandle>());
 }
 
 void SpatialGrid::clear() 
 {
-    cells_.clear();
+    clearCells();
+}
+
+void SpatialGrid::clearCells()
+{
+    for (auto& cell : cells_) cell.clear();
 }
 
 int SpatialGrid::cellIndexFor(const sf::Vector2f& p) const 
@@ -23,68 +31,181 @@ int SpatialGrid::cellIndexFor(const sf::Vector2f& p) const
     return row * cols_ + col;
 }
 
-void SpatialGrid::insert(int appleIndex, const sf::Vector2f& pos) 
+void SpatialGrid::insert(SlotHandle apple, const sf::Vector2f& pos) 
 {
     const int idx = cellIndexFor(pos);
-    cells_[idx].insert(appleIndex);
+    cells_[idx].push_back(apple);
 }
 
-void SpatialGrid::erase(int appleIndex, const sf::Vector2f& pos) 
+void SpatialGrid::erase(SlotHandle apple, const sf::Vector2f& pos) 
 {
     const int idx = cellIndexFor(pos);
-    auto it = cells_.find(idx);
-    if (it != cells_.end()) 
+    auto& cell = cells_[idx];
+    auto found = std::find(cell.begin(), cell.end(), apple);
+    if (found != cell.end())
     {
-        it->second.erase(appleIndex);
-        if (it->second.empty()) cells_.erase(it);
+        *found = cell.back();
+        cell.pop_back();
     }
 }
 
-void SpatialGrid::move(int appleIndex, const sf::Vector2f& oldPos, 
+void SpatialGrid::move(SlotHandle apple, const sf::Vector2f& oldPos, 
     const sf::Vector2f& newPos) 
 {
     const int oldIdx = cellIndexFor(oldPos);
     const int newIdx = cellIndexFor(newPos);
     if (oldIdx == newIdx) return;
-    erase(appleIndex, oldPos);
-    insert(appleIndex, newPos);
+    erase(apple, oldPos);
+    insert(apple, newPos);
 }
 
-void SpatialGrid::rebuild(const std::vector<std::unique_ptr<Apple>>& apples) 
+void SpatialGrid::prepareRebuild()
 {
     //  init()      Constants
     if (cols_ == 0 || rows_ == 0) 
     {
         init(Constants::SCREEN_WIDTH, Constants::SCREEN_HEIGHT, Constants::GRID_CELL_SIZE);
     }
-    cells_.clear();
-    for (int i = 0; i < static_cast<int>(apples.size()); ++i) 
+    clearCells();
+}
+
+void SpatialGrid::rebuild(const SlotMap<Apple>& apples) 
+{
+    prepareRebuild();
+    for (std::size_t i = 0; i < apples.size(); ++i) 
     {
-        const auto& a = apples[i];
-        if (!a || !a->active) continue;
-        insert(i, a->position);
+        insert(apples.handleAt(i), apples[i].position);
     }
 }
 
-void SpatialGrid::collectNear(const sf::Vector2f& pos, std::vector<int>& out) const 
+void SpatialGrid::rebuild(const SlotMap<Enemy>& enemies)
+{
+    prepareRebuild();
+    for (std::size_t i = 0; i < enemies.size(); ++i)
+    {
+        insert(enemies.handleAt(i), enemies[i].position);
+    }
+}
+
+void SpatialGrid::rebuild(const SlotMap<Obstacle>& obstacles)
+{
+    prepareRebuild();
+    for (std::size_t i = 0; i < obstacles.size(); ++i)
+    {
+        // position  -   
+        insertBounds(obstacles.handleAt(i), sf::FloatRect(obstacles[i].position, obstacles[i].getSize()));
+    }
+}
+
+void SpatialGrid::insertBounds(SlotHandle handle, const sf::FloatRect& bounds)
+{
+    const int minCol = clampCol_(static_cast<int>(std::floor(bounds.left / cellSize_)));
+    const int minRow = clampRow_(static_cast<int>(std::floor(bounds.top / cellSize_)));
+    const int maxCol = clampCol_(static_cast<int>(std::floor((bounds.left + bounds.width) / cellSize_)));
+    const int maxRow = clampRow_(static_cast<int>(std::floor((bounds.top + bounds.height) / cellSize_)));
+
+    for (int rr = minRow; rr <= maxRow; ++rr)
+    {
+        for (int cc = minCol; cc <= maxCol; ++cc) cells_[rr * cols_ + cc].push_back(handle);
+    }
+}
+
+void SpatialGrid::collectNear(const sf::Vector2f& pos, std::vector<SlotHandle>& out) const 
+{
+    out.clear();
+    if (cols_ == 0 || rows_ == 0) return;
+
+    const int col = clampCol_(static_cast<int>(pos.x) / cellSize_);
+    const int row = clampRow_(static_cast<int>(pos.y) / cellSize_);
+
+    collectCells(col - 1, row - 1, col + 1, row + 1, out);
+}
+
+void SpatialGrid::collectAlong(const sf::Vector2f& from, const sf::Vector2f& to,
+    std::vector<SlotHandle>& out) const
 {
     out.clear();
     if (cols_ == 0 || rows_ == 0) return;
 
+    //  ,  ,     
+    const int colA = clampCol_(static_cast<int>(from.x) / cellSize_);
+    const int rowA = clampRow_(static_cast<int>(from.y) / cellSize_);
+    const int colB = clampCol_(static_cast<int>(to.x) / cellSize_);
+    const int rowB = clampRow_(static_cast<int>(to.y) / cellSize_);
+
+    collectCells(std::min(colA, colB) - 1, std::min(rowA, rowB) - 1,
+        std::max(colA, colB) + 1, std::max(rowA, rowB) + 1, out);
+}
+
+void SpatialGrid::collectRadius(const sf::Vector2f& pos, float radius, std::vector<SlotHandle>& out) const
+{
+    out.clear();
+    if (cols_ == 0 || rows_ == 0) return;
+
+    collectCells(static_cast<int>(std::floor((pos.x - radius) / cellSize_)),
+        static_cast<int>(std::floor((pos.y - radius) / cellSize_)),
+        static_cast<int>(std::floor((pos.x + radius) / cellSize_)),
+        static_cast<int>(std::floor((pos.y + radius) / cellSize_)), out);
+}
+
+bool SpatialGrid::collectRing(const sf::Vector2f& pos, int ring, std::vector<SlotHandle>& out) const
+{
+    if (cols_ == 0 || rows_ == 0) return false;
+
     const int col = clampCol_(static_cast<int>(pos.x) / cellSize_);
     const int row = clampRow_(static_cast<int>(pos.y) / cellSize_);
+    if (col - ring < 0 && row - ring < 0 && col + ring >= cols_ && row + ring >= rows_) return false;
 
-    for (int dr = -1; dr <= 1; ++dr) 
+    if (ring == 0)
     {
-        for (int dc = -1; dc <= 1; ++dc) 
+        const auto& cell = cells_[row * cols_ + col];
+        out.insert(out.end(), cell.begin(), cell.end());
+        return true;
+    }
+
+    //      ,   -   
+    for (int rr = std::max(row - ring, 0); rr <= std::min(row + ring, rows_ - 1); ++rr)
+    {
+        const bool edgeRow = rr == row - ring || rr == row + ring;
+        const int step = edgeRow ? 1 : 2 * ring;
+        for (int cc = col - ring; cc <= col + ring; cc += step)
+        {
+            if (cc < 0 || cc >= cols_) continue;
+            const auto& cell = cells_[rr * cols_ + cc];
+            out.insert(out.end(), cell.begin(), cell.end());
+        }
+    }
+    return true;
+}
+
+void SpatialGrid::collectCells(int minCol, int minRow, int maxCol, int maxRow,
+    std::vector<SlotHandle>& out) const
+{
+    minCol = std::max(minCol, 0);
+    minRow = std::max(minRow, 0);
+    maxCol = std::min(maxCol, cols_ - 1);
+    maxRow = std::min(maxRow, rows_ - 1);
+
+    for (int rr = minRow; rr <= maxRow; ++rr) 
+    {
+        for (int cc = minCol; cc <= maxCol; ++cc) 
         {
-            const int rr = row + dr;
-            const int cc = col + dc;
-            if (rr < 0 || rr >= rows_ || cc < 0 || cc >= cols_) continue;
-            const int idx = rr * cols_ + cc;
-            auto it = cells_.find(idx);
-            if (it == cells_.end()) continue;
-            out.insert(out.end(), it->second.begin(), it->second.end());
+            const auto& cell = cells_[rr * cols_ + cc];
+            out.insert(out.end(), cell.begin(), cell.end());
         }
     }
+}
+
+SpatialGrid::Occupancy SpatialGrid::getOccupancy() const
+{
+    Occupancy occupancy;
+    occupancy.cells = static_cast<int>(cells_.size());
+    for (const auto& cell : cells_)
+    {
+        const int count = static_cast<int>(cell.size());
+        if (count > 0) ++occupancy.occupiedCells;
+        occupancy.maxPerCell = std::max(occupancy.maxPerCell, count);
+        occupancy.entries += count;
+    }
+    return occupancy;
 }
\ No newline at end of file
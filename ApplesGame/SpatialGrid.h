@@ -1,11 +1,15 @@
 #pragma once
+#include <SFML/Graphics/Rect.hpp>
 #include <SFML/System/Vector2.hpp>
+#include <algorithm>
+#include <cmath>
 #include <vector>
 #include <memory>
-#include <unordered_map>
-#include <unordered_set>
+#include "SlotMap.h"
 
 class Apple;
+class Enemy;
+class Obstacle;
 
 class SpatialGrid 
 {
@@ -15,28 +19,115 @@ public:
     //       
     void init(int screenWidth, int screenHeight, int cellSize);
 
-    //      
-    void rebuild(const std::vector<std::unique_ptr<Apple>>& apples);
+    //      /  (  )
+    void rebuild(const SlotMap<Apple>& apples);
+    void rebuild(const SlotMap<Enemy>& enemies);
+
+    //   :      ,
+    //  erase/move     
+    void rebuild(const SlotMap<Obstacle>& obstacles);
 
     //   //  
-    void insert(int appleIndex, const sf::Vector2f& pos);
-    void erase(int appleIndex, const sf::Vector2f& pos);
-    void move(int appleIndex, const sf::Vector2f& oldPos, const sf::Vector2f& newPos);
+    void insert(SlotHandle apple, const sf::Vector2f& pos);
+    void erase(SlotHandle apple, const sf::Vector2f& pos);
+    void move(SlotHandle apple, const sf::Vector2f& oldPos, const sf::Vector2f& newPos);
+
+    //        8  3x3
+    void collectNear(const sf::Vector2f& pos, std::vector<SlotHandle>& out) const;
+
+    //      from -> to (   )
+    void collectAlong(const sf::Vector2f& from, const sf::Vector2f& to, std::vector<SlotHandle>& out) const;
+
+    //    ,     pos, radius
+    void collectRadius(const sf::Vector2f& pos, float radius, std::vector<SlotHandle>& out) const;
 
-    //        8  3x3
-    void collectNear(const sf::Vector2f& pos, std::vector<int>& out) const;
+    //   out      ring ( )   pos;
+    // false -         
+    bool collectRing(const sf::Vector2f& pos, int ring, std::vector<SlotHandle>& out) const;
+
+    //     from -> to   (DDA). visit(cell, tExit) 
+    //         ; false -  
+    template <typename Visitor>
+    void traverse(const sf::Vector2f& from, const sf::Vector2f& to, Visitor visit) const;
+
+    int getCellSize() const { return cellSize_; }
 
     //  
     void clear();
 
+    //      (  )
+    struct Occupancy
+    {
+        int cells = 0;
+        int occupiedCells = 0;
+        int maxPerCell = 0;
+        int entries = 0;
+    };
+    Occupancy getOccupancy() const;
+
 private:
     int cellSize_ = 128;
     int cols_ = 0;
     int rows_ = 0;
     
-    std::unordered_map<int, std::unordered_set<int>> cells_;
+    //   :   ,    
+    std::vector<std::vector<SlotHandle>> cells_;
+    void clearCells();
+    void prepareRebuild();
+    void insertBounds(SlotHandle handle, const sf::FloatRect& bounds);
 
     inline int clampCol_(int c) const { return (c < 0 ? 0 : (c >= cols_ ? cols_ - 1 : c)); }
     inline int clampRow_(int r) const { return (r < 0 ? 0 : (r >= rows_ ? rows_ - 1 : r)); }
     int cellIndexFor(const sf::Vector2f& p) const;
-};
\ No newline at end of file
+    void collectCells(int minCol, int minRow, int maxCol, int maxRow, std::vector<SlotHandle>& out) const;
+};
+
+template <typename Visitor>
+void SpatialGrid::traverse(const sf::Vector2f& from, const sf::Vector2f& to, Visitor visit) const
+{
+    if (cols_ == 0 || rows_ == 0) return;
+
+    int col = clampCol_(static_cast<int>(std::floor(from.x / cellSize_)));
+    int row = clampRow_(static_cast<int>(std::floor(from.y / cellSize_)));
+    const int lastCol = clampCol_(static_cast<int>(std::floor(to.x / cellSize_)));
+    const int lastRow = clampRow_(static_cast<int>(std::floor(to.y / cellSize_)));
+
+    const sf::Vector2f delta = to - from;
+    const int stepCol = delta.x > 0.0f ? 1 : -1;
+    const int stepRow = delta.y > 0.0f ? 1 : -1;
+
+    //             
+    const float infinity = 1e30f;
+    float nextX = infinity, nextY = infinity, stepX = infinity, stepY = infinity;
+    if (delta.x != 0.0f)
+    {
+        const float border = static_cast<float>((col + (stepCol > 0 ? 1 : 0)) * cellSize_);
+        nextX = (border - from.x) / delta.x;
+        stepX = cellSize_ / std::abs(delta.x);
+    }
+    if (delta.y != 0.0f)
+    {
+        const float border = static_cast<float>((row + (stepRow > 0 ? 1 : 0)) * cellSize_);
+        nextY = (border - from.y) / delta.y;
+        stepY = cellSize_ / std::abs(delta.y);
+    }
+
+    while (true)
+    {
+        const bool last = col == lastCol && row == lastRow;
+        const float exit = last ? 1.0f : std::min(std::min(nextX, nextY), 1.0f);
+        if (!visit(cells_[row * cols_ + col], exit) || last) return;
+
+        if (nextX < nextY)
+        {
+            col += stepCol;
+            nextX += stepX;
+        }
+        else
+        {
+            row += stepRow;
+            nextY += stepY;
+        }
+        if (col < 0 || col >= cols_ || row < 0 || row >= rows_) return;
+    }
+}
\ No newline at end of file
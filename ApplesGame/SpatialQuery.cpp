@@ -0,0 +1,127 @@
+﻿#include <algorithm>
+#include "SpatialQuery.h"
+#include "CollisionSystem.h"
+
+namespace
+{
+    bool closer(const SpatialQuery::Neighbor& a, const SpatialQuery::Neighbor& b)
+    {
+        return a.distanceSq < b.distanceSq;
+    }
+}
+
+SpatialQuery::SpatialQuery(const SlotMap<Apple>& apples, const SpatialGrid& appleGrid,
+    const SlotMap<Enemy>& enemies, const SpatialGrid& enemyGrid,
+    const SlotMap<Obstacle>& obstacles, const SpatialGrid& obstacleGrid)
+    : apples(apples), appleGrid(appleGrid), enemies(enemies), enemyGrid(enemyGrid),
+    obstacles(obstacles), obstacleGrid(obstacleGrid)
+{
+}
+
+int SpatialQuery::nearestApples(const sf::Vector2f& position, int k, std::vector<Neighbor>& out) const
+{
+    out.clear();
+    if (k <= 0) return 0;
+
+    const float cellSize = static_cast<float>(appleGrid.getCellSize());
+    for (int ring = 0; ; ++ring)
+    {
+        candidates.clear();
+        if (!appleGrid.collectRing(position, ring, candidates)) break;
+
+        for (SlotHandle handle : candidates)
+        {
+            const Apple* apple = apples.get(handle);
+            if (!apple) continue;
+            const sf::Vector2f delta = apple->position - position;
+            out.push_back({ handle, apple->position, delta.x * delta.x + delta.y * delta.y });
+        }
+
+        // Яблоки за кольцом ring дальше ring * cellSize: если k-е найденное ближе, поиск окончен
+        if (static_cast<int>(out.size()) >= k)
+        {
+            std::nth_element(out.begin(), out.begin() + (k - 1), out.end(), closer);
+            const float bound = ring * cellSize;
+            if (out[k - 1].distanceSq <= bound * bound) break;
+        }
+    }
+
+    const int found = std::min(k, static_cast<int>(out.size()));
+    std::partial_sort(out.begin(), out.begin() + found, out.end(), closer);
+    out.resize(found);
+    return found;
+}
+
+int SpatialQuery::entitiesInRadius(const sf::Vector2f& position, float radius, std::vector<EntityRef>& out) const
+{
+    out.clear();
+    const float radiusSq = radius * radius;
+
+    appleGrid.collectRadius(position, radius, candidates);
+    for (SlotHandle handle : candidates)
+    {
+        const Apple* apple = apples.get(handle);
+        if (!apple) continue;
+        const sf::Vector2f delta = apple->position - position;
+        if (delta.x * delta.x + delta.y * delta.y <= radiusSq) out.push_back({ CollisionType::Apple, handle });
+    }
+
+    enemyGrid.collectRadius(position, radius, candidates);
+    for (SlotHandle handle : candidates)
+    {
+        const Enemy* enemy = enemies.get(handle);
+        if (!enemy) continue;
+        const sf::Vector2f delta = enemy->position - position;
+        if (delta.x * delta.x + delta.y * delta.y <= radiusSq) out.push_back({ CollisionType::Enemy, handle });
+    }
+
+    // Препятствие лежит в нескольких ячейках: дубликаты убираются до проверки
+    obstacleGrid.collectRadius(position, radius, candidates);
+    std::sort(candidates.begin(), candidates.end());
+    candidates.erase(std::unique(candidates.begin(), candidates.end()), candidates.end());
+    for (SlotHandle handle : candidates)
+    {
+        const Obstacle* obstacle = obstacles.get(handle);
+        if (!obstacle) continue;
+
+        // Ближайшая к центру точка прямоугольника
+        const sf::Vector2f size = obstacle->getSize();
+        const float nearestX = std::min(std::max(position.x, obstacle->position.x), obstacle->position.x + size.x);
+        const float nearestY = std::min(std::max(position.y, obstacle->position.y), obstacle->position.y + size.y);
+        const float dx = position.x - nearestX;
+        const float dy = position.y - nearestY;
+        if (dx * dx + dy * dy <= radiusSq) out.push_back({ CollisionType::Obstacle, handle });
+    }
+
+    return static_cast<int>(out.size());
+}
+
+bool SpatialQuery::raycastObstacles(const sf::Vector2f& from, const sf::Vector2f& to, RayHit& hit) const
+{
+    bool found = false;
+    hit.fraction = 1.0f;
+
+    obstacleGrid.traverse(from, to, [&](const std::vector<SlotHandle>& cell, float exit)
+    {
+        for (SlotHandle handle : cell)
+        {
+            const Obstacle* obstacle = obstacles.get(handle);
+            if (!obstacle) continue;
+
+            float fraction = 0.0f;
+            if (Collision::segmentRect(from, to, obstacle->position, obstacle->position + obstacle->getSize(), fraction)
+                && (!found || fraction < hit.fraction))
+            {
+                hit.obstacle = handle;
+                hit.fraction = fraction;
+                found = true;
+            }
+        }
+
+        // Попадание внутри текущей ячейки ближе всего, что лежит в следующих
+        return !(found && hit.fraction <= exit);
+    });
+
+    if (found) hit.point = from + (to - from) * hit.fraction;
+    return found;
+}
@@ -0,0 +1,70 @@
+﻿/*
+Пространственные запросы к миру поверх сеток broadphase.
+
+- nearestApples: k ближайших яблок, поиск кольцами ячеек от позиции
+  с остановкой, как только k-е найденное ближе непросмотренных колец.
+- entitiesInRadius: яблоки, противники и препятствия в круге радиуса r.
+- raycastObstacles: первое препятствие на отрезке; ячейки обходятся по
+  порядку вдоль луча, и обход прекращается на первой ячейке с попаданием.
+- Результаты пишутся в буферы вызывающего; внутренний буфер кандидатов
+  переиспользуется, поэтому запросы не выделяют память после прогрева.
+- Сетки должны быть актуальны: яблоки обновляются точечно, противники
+  перестраиваются каждый тик, препятствия - при спавне.
+*/
+
+#pragma once
+#include <SFML/System/Vector2.hpp>
+#include <vector>
+#include "Apple.h"
+#include "Enemy.h"
+#include "Obstacle.h"
+#include "Enums.h"
+#include "SlotMap.h"
+#include "SpatialGrid.h"
+
+class SpatialQuery
+{
+public:
+    struct Neighbor
+    {
+        SlotHandle handle;
+        sf::Vector2f position;
+        float distanceSq;
+    };
+
+    struct EntityRef
+    {
+        CollisionType type; // Apple, Enemy или Obstacle
+        SlotHandle handle;
+    };
+
+    struct RayHit
+    {
+        SlotHandle obstacle;
+        float fraction;     // доля отрезка до точки входа
+        sf::Vector2f point;
+    };
+
+    SpatialQuery(const SlotMap<Apple>& apples, const SpatialGrid& appleGrid,
+        const SlotMap<Enemy>& enemies, const SpatialGrid& enemyGrid,
+        const SlotMap<Obstacle>& obstacles, const SpatialGrid& obstacleGrid);
+
+    // До k ближайших яблок по возрастанию расстояния; возвращает число найденных
+    int nearestApples(const sf::Vector2f& position, int k, std::vector<Neighbor>& out) const;
+
+    // Все объекты, пересекающие круг (центры яблок и противников, прямоугольники препятствий)
+    int entitiesInRadius(const sf::Vector2f& position, float radius, std::vector<EntityRef>& out) const;
+
+    // Первое препятствие на отрезке from -> to
+    bool raycastObstacles(const sf::Vector2f& from, const sf::Vector2f& to, RayHit& hit) const;
+
+private:
+    const SlotMap<Apple>& apples;
+    const SpatialGrid& appleGrid;
+    const SlotMap<Enemy>& enemies;
+    const SpatialGrid& enemyGrid;
+    const SlotMap<Obstacle>& obstacles;
+    const SpatialGrid& obstacleGrid;
+
+    mutable std::vector<SlotHandle> candidates;
+};
@@ -0,0 +1,59 @@
+﻿#include "StaticLayer.h"
+
+void StaticLayer::init(unsigned width, unsigned height)
+{
+    available = texture.create(width, height);
+    if (available)
+    {
+        sprite.setTexture(texture.getTexture(), true);
+    }
+    dirty = true;
+}
+
+void StaticLayer::invalidate()
+{
+    dirty = true;
+}
+
+void StaticLayer::rebuild(const SlotMap<Obstacle>& obstacles, const sf::Color& tint)
+{
+    texture.clear(sf::Color::Transparent);
+
+    for (const auto& obstacle : obstacles)
+    {
+        // Рисует копию формы, чтобы не трогать цвет самого препятствия
+        sf::RectangleShape shape = obstacle.shape;
+        shape.setPosition(obstacle.position);
+        if (tint != sf::Color::Transparent) shape.setFillColor(tint);
+        texture.draw(shape);
+    }
+
+    texture.display();
+    cachedTint = tint;
+    dirty = false;
+}
+
+void StaticLayer::draw(CountingRenderTarget& target,
+    const SlotMap<Obstacle>& obstacles,
+    const sf::Color& tint)
+{
+    // Запасной путь без RenderTexture
+    if (!available)
+    {
+        for (const auto& obstacle : obstacles)
+        {
+            sf::RectangleShape shape = obstacle.shape;
+            shape.setPosition(obstacle.position);
+            if (tint != sf::Color::Transparent) shape.setFillColor(tint);
+            target.draw(shape);
+        }
+        return;
+    }
+
+    if (dirty || tint != cachedTint)
+    {
+        rebuild(obstacles, tint);
+    }
+
+    target.draw(sprite);
+}
@@ -0,0 +1,43 @@
+﻿/*
+Кэш статического слоя сцены.
+
+- Препятствия не двигаются после spawnObstacles(), поэтому они один раз
+  растеризуются в sf::RenderTexture и выводятся одним спрайтом.
+- Слой перестраивается только после invalidate() (респавн препятствий)
+  или при смене цвета заливки (серый тинт паузы).
+- Затемнение при переходах делает общий fadeOverlay Game поверх кадра,
+  собственной прозрачности у слоя нет.
+- Если RenderTexture недоступна, препятствия рисуются напрямую.
+*/
+
+#pragma once
+#include <SFML/Graphics.hpp>
+#include "Obstacle.h"
+#include "SlotMap.h"
+#include "CountingRenderTarget.h"
+
+class StaticLayer
+{
+public:
+    StaticLayer() = default;
+
+    // Создает текстуру слоя по размеру экрана
+    void init(unsigned width, unsigned height);
+
+    // Помечает слой устаревшим (препятствия пересозданы)
+    void invalidate();
+
+    // Рисует слой; tint != Transparent заменяет цвет заливки всех препятствий
+    void draw(CountingRenderTarget& target,
+        const SlotMap<Obstacle>& obstacles,
+        const sf::Color& tint = sf::Color::Transparent);
+
+private:
+    sf::RenderTexture texture;
+    sf::Sprite sprite;
+    sf::Color cachedTint = sf::Color::Transparent;
+    bool available = false;
+    bool dirty = true;
+
+    void rebuild(const SlotMap<Obstacle>& obstacles, const sf::Color& tint);
+};
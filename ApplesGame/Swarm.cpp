@@ -0,0 +1,359 @@
+﻿#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include "Swarm.h"
+#include "Constants.h"
+#include "CollisionSystem.h"
+
+namespace
+{
+    const float CELL_SIZE = Constants::SWARM_NEIGHBOR_RADIUS;
+    const float NEIGHBOR_RADIUS_SQ = Constants::SWARM_NEIGHBOR_RADIUS * Constants::SWARM_NEIGHBOR_RADIUS;
+
+    // Веса правил стаи (ускорение в px/s^2)
+    const float SEPARATION_WEIGHT = 2000.0f;
+    const float ALIGNMENT_WEIGHT = 1.0f;
+    const float COHESION_WEIGHT = 0.8f;
+    const float SEEK_WEIGHT = 2.0f;
+    const float WALL_WEIGHT = 10.0f;
+    const float WALL_MARGIN = 40.0f;
+    const float MIN_SPEED = Constants::SWARM_MAX_SPEED * 0.4f;
+
+    float randomUnit()
+    {
+        return static_cast<float>(rand()) / RAND_MAX;
+    }
+}
+
+void Swarm::init(int screenWidth, int screenHeight)
+{
+    width = static_cast<float>(screenWidth);
+    height = static_cast<float>(screenHeight);
+    cols = static_cast<int>(std::ceil(width / CELL_SIZE));
+    rows = static_cast<int>(std::ceil(height / CELL_SIZE));
+    cellStart.assign(cols * rows + 1, 0);
+    cellCursor.assign(cols * rows, 0);
+    vertices.setPrimitiveType(sf::Quads);
+}
+
+void Swarm::clear()
+{
+    x.clear();
+    y.clear();
+    vx.clear();
+    vy.clear();
+}
+
+void Swarm::spawn(int count, const sf::Vector2f& safeCenter, float safeRadius)
+{
+    clear();
+
+    // Буферы растут один раз до наибольшей стаи и дальше переиспользуются
+    for (auto* buffer : { &x, &y, &vx, &vy, &sortedX, &sortedY, &sortedVx, &sortedVy,
+        &separationX, &separationY, &sumVx, &sumVy, &sumX, &sumY, &neighbors, &seekX, &seekY })
+    {
+        buffer->reserve(count);
+    }
+    cellOf.reserve(count);
+
+    while (static_cast<int>(x.size()) < count)
+    {
+        const float px = randomUnit() * width;
+        const float py = randomUnit() * height;
+        const float dx = px - safeCenter.x;
+        const float dy = py - safeCenter.y;
+        if (dx * dx + dy * dy < safeRadius * safeRadius) continue;
+
+        const float angle = randomUnit() * 6.2831853f;
+        x.push_back(px);
+        y.push_back(py);
+        vx.push_back(std::cos(angle) * Constants::SWARM_MAX_SPEED * 0.5f);
+        vy.push_back(std::sin(angle) * Constants::SWARM_MAX_SPEED * 0.5f);
+    }
+
+    const std::size_t n = x.size();
+    for (auto* buffer : { &sortedX, &sortedY, &sortedVx, &sortedVy, &separationX, &separationY,
+        &sumVx, &sumVy, &sumX, &sumY, &neighbors, &seekX, &seekY })
+    {
+        buffer->resize(n);
+    }
+    cellOf.resize(n);
+}
+
+int Swarm::cellFor(float px, float py) const
+{
+    const int col = std::min(std::max(static_cast<int>(px / CELL_SIZE), 0), cols - 1);
+    const int row = std::min(std::max(static_cast<int>(py / CELL_SIZE), 0), rows - 1);
+    return row * cols + col;
+}
+
+void Swarm::update(float deltaTime, const FlowField* field)
+{
+    if (x.empty()) return;
+
+    rebuildGrid();
+    accumulateNeighbors();
+    computeSeek(field);
+    integrate(deltaTime);
+}
+
+// Сортировка подсчетом по клеткам: гистограмма, префиксные суммы, раскладка
+void Swarm::rebuildGrid()
+{
+    const int n = size();
+    std::fill(cellStart.begin(), cellStart.end(), 0);
+
+    for (int i = 0; i < n; ++i)
+    {
+        cellOf[i] = cellFor(x[i], y[i]);
+        ++cellStart[cellOf[i] + 1];
+    }
+    for (int c = 0; c < cols * rows; ++c)
+    {
+        cellStart[c + 1] += cellStart[c];
+        cellCursor[c] = cellStart[c];
+    }
+    for (int i = 0; i < n; ++i)
+    {
+        const int slot = cellCursor[cellOf[i]]++;
+        sortedX[slot] = x[i];
+        sortedY[slot] = y[i];
+        sortedVx[slot] = vx[i];
+        sortedVy[slot] = vy[i];
+    }
+
+    x.swap(sortedX);
+    y.swap(sortedY);
+    vx.swap(sortedVx);
+    vy.swap(sortedVy);
+}
+
+// Суммы по соседям из 3x3 клеток. Внутренний цикл идет по подряд лежащим
+// особям клетки без ветвлений: радиус учитывается маской, вклад самой особи
+// вычитается после цикла
+void Swarm::accumulateNeighbors()
+{
+    for (int row = 0; row < rows; ++row)
+    {
+        for (int col = 0; col < cols; ++col)
+        {
+            const int cell = row * cols + col;
+            const int minRow = std::max(row - 1, 0);
+            const int maxRow = std::min(row + 1, rows - 1);
+            const int minCol = std::max(col - 1, 0);
+            const int maxCol = std::min(col + 1, cols - 1);
+
+            for (int i = cellStart[cell]; i < cellStart[cell + 1]; ++i)
+            {
+                const float px = x[i];
+                const float py = y[i];
+                float sepX = 0.0f, sepY = 0.0f;
+                float velX = 0.0f, velY = 0.0f;
+                float posX = 0.0f, posY = 0.0f;
+                float count = 0.0f;
+
+                for (int r = minRow; r <= maxRow; ++r)
+                {
+                    const int begin = cellStart[r * cols + minCol];
+                    const int end = cellStart[r * cols + maxCol + 1];
+                    for (int j = begin; j < end; ++j)
+                    {
+                        const float dx = px - x[j];
+                        const float dy = py - y[j];
+                        const float distanceSq = dx * dx + dy * dy;
+                        const float inside = distanceSq < NEIGHBOR_RADIUS_SQ ? 1.0f : 0.0f;
+                        const float inverse = inside / std::max(distanceSq, 1.0f);
+
+                        sepX += dx * inverse;
+                        sepY += dy * inverse;
+                        velX += vx[j] * inside;
+                        velY += vy[j] * inside;
+                        posX += x[j] * inside;
+                        posY += y[j] * inside;
+                        count += inside;
+                    }
+                }
+
+                separationX[i] = sepX;
+                separationY[i] = sepY;
+                sumVx[i] = velX - vx[i];
+                sumVy[i] = velY - vy[i];
+                sumX[i] = posX - px;
+                sumY[i] = posY - py;
+                neighbors[i] = count - 1.0f;
+            }
+        }
+    }
+}
+
+void Swarm::computeSeek(const FlowField* field)
+{
+    const int n = size();
+    if (!field)
+    {
+        // Цель совпадает с текущей скоростью: сила следования нулевая
+        std::copy(vx.begin(), vx.end(), seekX.begin());
+        std::copy(vy.begin(), vy.end(), seekY.begin());
+        return;
+    }
+    for (int i = 0; i < n; ++i)
+    {
+        const sf::Vector2f direction = field->getDirection(sf::Vector2f(x[i], y[i]));
+        seekX[i] = direction.x * Constants::SWARM_MAX_SPEED;
+        seekY[i] = direction.y * Constants::SWARM_MAX_SPEED;
+    }
+}
+
+// Ускорение, ограничение скорости и перемещение - плоский цикл по массивам
+void Swarm::integrate(float deltaTime)
+{
+    const int n = size();
+    const float radius = Constants::SWARM_RADIUS;
+
+    for (int i = 0; i < n; ++i)
+    {
+        const float hasNeighbors = neighbors[i] > 0.0f ? 1.0f : 0.0f;
+        const float inverseCount = hasNeighbors / std::max(neighbors[i], 1.0f);
+
+        const float wallX = std::max(WALL_MARGIN - x[i], 0.0f) - std::max(x[i] - (width - WALL_MARGIN), 0.0f);
+        const float wallY = std::max(WALL_MARGIN - y[i], 0.0f) - std::max(y[i] - (height - WALL_MARGIN), 0.0f);
+
+        const float ax = SEPARATION_WEIGHT * separationX[i]
+            + ALIGNMENT_WEIGHT * (sumVx[i] * inverseCount - vx[i] * hasNeighbors)
+            + COHESION_WEIGHT * (sumX[i] * inverseCount - x[i] * hasNeighbors)
+            + SEEK_WEIGHT * (seekX[i] - vx[i])
+            + WALL_WEIGHT * wallX;
+        const float ay = SEPARATION_WEIGHT * separationY[i]
+            + ALIGNMENT_WEIGHT * (sumVy[i] * inverseCount - vy[i] * hasNeighbors)
+            + COHESION_WEIGHT * (sumY[i] * inverseCount - y[i] * hasNeighbors)
+            + SEEK_WEIGHT * (seekY[i] - vy[i])
+            + WALL_WEIGHT * wallY;
+
+        float velocityX = vx[i] + ax * deltaTime;
+        float velocityY = vy[i] + ay * deltaTime;
+
+        // Скорость держится в [MIN_SPEED, SWARM_MAX_SPEED]
+        const float speed = std::sqrt(velocityX * velocityX + velocityY * velocityY);
+        const float clamped = std::min(std::max(speed, MIN_SPEED), Constants::SWARM_MAX_SPEED);
+        const float scale = clamped / std::max(speed, 0.0001f);
+        velocityX *= scale;
+        velocityY *= scale;
+
+        vx[i] = velocityX;
+        vy[i] = velocityY;
+        x[i] = std::min(std::max(x[i] + velocityX * deltaTime, radius), width - radius);
+        y[i] = std::min(std::max(y[i] + velocityY * deltaTime, radius), height - radius);
+    }
+}
+
+void Swarm::collideObstacles(const SlotMap<Obstacle>& obstacles, const SpatialGrid& obstacleGrid)
+{
+    const int n = size();
+    const float radius = Constants::SWARM_RADIUS;
+
+    for (int i = 0; i < n; ++i)
+    {
+        obstacleGrid.collectNear(sf::Vector2f(x[i], y[i]), nearObstacles);
+        for (SlotHandle handle : nearObstacles)
+        {
+            const Obstacle* obstacle = obstacles.get(handle);
+            if (!obstacle) continue;
+            const sf::Vector2f min = obstacle->position;
+            const sf::Vector2f max = obstacle->position + obstacle->getSize();
+
+            // Ближайшая к центру точка прямоугольника
+            const float nearestX = std::min(std::max(x[i], min.x), max.x);
+            const float nearestY = std::min(std::max(y[i], min.y), max.y);
+            float normalX = x[i] - nearestX;
+            float normalY = y[i] - nearestY;
+            const float distanceSq = normalX * normalX + normalY * normalY;
+            if (distanceSq >= radius * radius) continue;
+
+            float depth;
+            if (distanceSq > 0.0f)
+            {
+                const float distance = std::sqrt(distanceSq);
+                normalX /= distance;
+                normalY /= distance;
+                depth = radius - distance;
+            }
+            else
+            {
+                // Центр внутри: наружу через ближайшую сторону
+                const float left = x[i] - min.x, right = max.x - x[i];
+                const float top = y[i] - min.y, bottom = max.y - y[i];
+                const float nearest = std::min(std::min(left, right), std::min(top, bottom));
+                normalX = nearest == left ? -1.0f : (nearest == right ? 1.0f : 0.0f);
+                normalY = normalX != 0.0f ? 0.0f : (nearest == top ? -1.0f : 1.0f);
+                depth = nearest + radius;
+            }
+
+            x[i] += normalX * depth;
+            y[i] += normalY * depth;
+            const float into = vx[i] * normalX + vy[i] * normalY;
+            if (into < 0.0f)
+            {
+                vx[i] -= into * normalX;
+                vy[i] -= into * normalY;
+            }
+        }
+    }
+}
+
+bool Swarm::hitsCircle(const sf::Vector2f& from, const sf::Vector2f& to, float radius, float& timeOfImpact) const
+{
+    if (x.empty()) return false;
+
+    // Сетка построена до перемещения в integrate(): запас в одну клетку
+    const float reach = radius + Constants::SWARM_RADIUS + CELL_SIZE;
+    const int first = cellFor(std::min(from.x, to.x) - reach, std::min(from.y, to.y) - reach);
+    const int last = cellFor(std::max(from.x, to.x) + reach, std::max(from.y, to.y) + reach);
+    const int minCol = first % cols, minRow = first / cols;
+    const int maxCol = last % cols, maxRow = last / cols;
+
+    bool hit = false;
+    timeOfImpact = 1.0f;
+    for (int row = minRow; row <= maxRow; ++row)
+    {
+        const int begin = cellStart[row * cols + minCol];
+        const int end = cellStart[row * cols + maxCol + 1];
+        for (int i = begin; i < end; ++i)
+        {
+            float t = 0.0f;
+            if (Collision::sweptCircleCircle(from, to, radius, sf::Vector2f(x[i], y[i]), Constants::SWARM_RADIUS, t)
+                && t <= timeOfImpact)
+            {
+                timeOfImpact = t;
+                hit = true;
+            }
+        }
+    }
+    return hit;
+}
+
+void Swarm::draw(CountingRenderTarget& target, const sf::Texture& texture, const sf::Color& color)
+{
+    const int n = size();
+    if (n == 0) return;
+
+    vertices.resize(static_cast<std::size_t>(n) * 4);
+    const float half = Constants::SWARM_RADIUS * 1.5f;
+    const sf::Vector2f textureSize(texture.getSize());
+
+    for (int i = 0; i < n; ++i)
+    {
+        // Ось текстуры x смотрит по скорости, y - вбок (как поворот спрайта Enemy)
+        const float speed = std::sqrt(vx[i] * vx[i] + vy[i] * vy[i]);
+        const sf::Vector2f forward = speed > 0.0001f ? sf::Vector2f(vx[i] / speed, vy[i] / speed) : sf::Vector2f(1.0f, 0.0f);
+        const sf::Vector2f side(-forward.y, forward.x);
+        const sf::Vector2f center(x[i], y[i]);
+
+        sf::Vertex* quad = &vertices[static_cast<std::size_t>(i) * 4];
+        quad[0] = sf::Vertex(center - forward * half - side * half, color, sf::Vector2f(0.0f, 0.0f));
+        quad[1] = sf::Vertex(center + forward * half - side * half, color, sf::Vector2f(textureSize.x, 0.0f));
+        quad[2] = sf::Vertex(center + forward * half + side * half, color, textureSize);
+        quad[3] = sf::Vertex(center - forward * half + side * half, color, sf::Vector2f(0.0f, textureSize.y));
+    }
+
+    target.draw(vertices, sf::RenderStates(&texture));
+}
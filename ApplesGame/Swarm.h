@@ -0,0 +1,83 @@
+﻿/*
+Стая противников для режима SWARM (тысячи особей).
+
+- Данные хранятся структурой массивов (x, y, vx, vy): шаг стаи - несколько
+  плоских циклов по float без ветвлений, которые компилятор векторизует.
+- Сетка соседей перестраивается каждый тик сортировкой подсчетом: особи
+  переставляются в порядке клеток, и соседи одной клетки лежат в памяти
+  подряд.
+- Правила стаи: разделение, выравнивание скоростей и сплочение по соседям
+  в радиусе SWARM_NEIGHBOR_RADIUS, мягкое отталкивание от краев экрана.
+  В режиме CHASE стая дополнительно следует полю потока к игроку.
+- Препятствия твердые: после шага особь выталкивается из пересеченных
+  прямоугольников (кандидаты - из сетки препятствий Game), скорость
+  в сторону препятствия гасится.
+- Рисуется одним массивом вершин с текстурой противника; поворот каждой
+  особи берется из направления скорости без тригонометрии.
+*/
+
+#pragma once
+#include <SFML/Graphics.hpp>
+#include <vector>
+#include "CountingRenderTarget.h"
+#include "FlowField.h"
+#include "Obstacle.h"
+#include "SlotMap.h"
+#include "SpatialGrid.h"
+
+class Swarm
+{
+public:
+    void init(int screenWidth, int screenHeight);
+
+    // count особей вне круга safeRadius вокруг safeCenter (стартовая позиция игрока)
+    void spawn(int count, const sf::Vector2f& safeCenter, float safeRadius);
+    void clear();
+
+    int size() const { return static_cast<int>(x.size()); }
+    bool empty() const { return x.empty(); }
+
+    // Позиции особей (растр занятости)
+    const std::vector<float>& getPositionsX() const { return x; }
+    const std::vector<float>& getPositionsY() const { return y; }
+
+    // Шаг стаи; field != nullptr - следовать полю потока
+    void update(float deltaTime, const FlowField* field);
+
+    // После update(): выталкивает особи из препятствий
+    void collideObstacles(const SlotMap<Obstacle>& obstacles, const SpatialGrid& obstacleGrid);
+
+    // Пересекает ли круг, движущийся from -> to, хоть одну особь; timeOfImpact - доля пути
+    bool hitsCircle(const sf::Vector2f& from, const sf::Vector2f& to, float radius, float& timeOfImpact) const;
+
+    void draw(CountingRenderTarget& target, const sf::Texture& texture, const sf::Color& color);
+
+private:
+    float width = 0.0f;
+    float height = 0.0f;
+    int cols = 0;
+    int rows = 0;
+
+    // Состояние особей (в порядке клеток после rebuildGrid)
+    std::vector<float> x, y, vx, vy;
+
+    // Буферы перестановки и сумм по соседям
+    std::vector<float> sortedX, sortedY, sortedVx, sortedVy;
+    std::vector<float> separationX, separationY;
+    std::vector<float> sumVx, sumVy, sumX, sumY, neighbors;
+    std::vector<float> seekX, seekY;
+
+    // Сетка: особи клетки c лежат в [cellStart[c], cellStart[c + 1])
+    std::vector<int> cellOf;
+    std::vector<int> cellStart;
+    std::vector<int> cellCursor;
+
+    std::vector<SlotHandle> nearObstacles; // буфер кандидатов из сетки препятствий
+    sf::VertexArray vertices;
+
+    int cellFor(float px, float py) const;
+    void rebuildGrid();
+    void accumulateNeighbors();
+    void computeSeek(const FlowField* field);
+    void integrate(float deltaTime);
+};
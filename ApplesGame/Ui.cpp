@@ -30,12 +30,13 @@
 */
 
 #include <algorithm>
+#include <cstdio>
 #include "UI.h"
 #include "Enums.h"
 
 UIHandler::UIHandler(const MenuConfig& config)
     : font(config.font), menuSound(config.menuSound), selectSound(config.selectSound),
-           blinkSpeed(Constants::MENU_TITLE_OUTLINE_BLINK_SPEED)
+           frameArena(config.frameArena), blinkSpeed(Constants::MENU_TITLE_OUTLINE_BLINK_SPEED)
 {}
 
 //   
@@ -167,6 +168,8 @@ int UIHandler::showModeSelectionMenu(sf::RenderWindow& window)
         "[2] Unlimited Apples",
         "[3] Acceleration Mode",
         "[4] No Accelerartion Mode",
+        "[5] Chase Mode",
+        "[6] Swarm Mode",
         "[Enter] Start Playing"
     };
 
@@ -201,6 +204,12 @@ int UIHandler::showModeSelectionMenu(sf::RenderWindow& window)
                 case sf::Keyboard::Num4:
                     gameModeMask ^= NO_SPEED_UP;
                     break;
+                case sf::Keyboard::Num5:
+                    gameModeMask ^= CHASE;
+                    break;
+                case sf::Keyboard::Num6:
+                    gameModeMask ^= SWARM;
+                    break;
                 case sf::Keyboard::Enter:
                     //  
                     if ((gameModeMask & LIMITED_APPLES) && (gameModeMask & UNLIMITED_APPLES))
@@ -218,7 +227,7 @@ int UIHandler::showModeSelectionMenu(sf::RenderWindow& window)
         for (size_t i = 0; i < options.size(); ++i) 
         {
             std::string label = options[i];
-            if (i < 4 && HasGameMode(gameModeMask, static_cast<GameMode>(1 << i))) 
+            if (i < 6 && HasGameMode(gameModeMask, static_cast<GameMode>(1 << i))) 
             {
                 label += " [ON]";
             }
@@ -269,7 +278,7 @@ void UIHandler::updateMenuVisuals(Menu& menu)
 }
 
 //   
-void UIHandler::drawMainMenu(sf::RenderWindow& window)
+void UIHandler::drawMainMenu(CountingRenderTarget& window)
 {
     float alpha = (sin(outlineBlinkClock.getElapsedTime().asSeconds() * outlineBlinkSpeed) + 1) * 127.5f;
     mainMenu.title.setOutlineColor(sf::Color(208, 248, 20, static_cast<sf::Uint8>(alpha)));
@@ -282,7 +291,7 @@ void UIHandler::drawMainMenu(sf::RenderWindow& window)
 }
 
 //   
-void UIHandler::drawPauseMenu(sf::RenderWindow& window)
+void UIHandler::drawPauseMenu(CountingRenderTarget& window)
 {
     window.draw(pauseMenu.title);
     for (const auto& item : pauseMenu.items)
@@ -298,19 +307,54 @@ void UIHandler::resetPauseMenu()
     updateMenuVisuals(pauseMenu);
 }
 
+void UIHandler::setTextIfChanged(sf::Text& text, std::string& shown, const char* value)
+{
+    if (shown == value) return;
+    shown = value;
+    text.setString(shown);
+}
+
+//     (     )
+void UIHandler::initLeaderboardTexts()
+{
+    if (leaderboardTextsReady) return;
+
+    leaderboardTitle.setFont(font);
+    leaderboardTitle.setCharacterSize(28);
+    leaderboardTitle.setFillColor(sf::Color::White);
+    leaderboardTitle.setString("LEADERBOARD");
+
+    rankLine.text.setFont(font);
+    rankLine.text.setCharacterSize(22);
+    rankLine.text.setFillColor(sf::Color(255, 230, 80));
+
+    leaderboardOverlay.setSize(sf::Vector2f(Constants::SCREEN_WIDTH, Constants::SCREEN_HEIGHT));
+    leaderboardOverlay.setFillColor(sf::Color(0, 0, 0, 160));
+
+    highlightsTitle.setFont(font);
+    highlightsTitle.setCharacterSize(48);
+    highlightsTitle.setFillColor(sf::Color::White);
+    highlightsTitle.setString("HIGHLIGHTS");
+
+    backHint.setFont(font);
+    backHint.setCharacterSize(20);
+    backHint.setFillColor(sf::Color(200, 200, 200));
+    backHint.setString("Enter / Esc - back to Main Menu ");
+
+    leaderboardTextsReady = true;
+}
+
 //  
-void UIHandler::drawLeaderboard(sf::RenderWindow& window,
+void UIHandler::drawLeaderboard(CountingRenderTarget& window,
     const std::vector<std::pair<std::string, int>>& rows,
     int highlightIndex,
     float startY,
     int maxRows)
 {
+    initLeaderboardTexts();
+
     // 
-    sf::Text title;
-    title.setFont(font);
-    title.setCharacterSize(28);
-    title.setFillColor(sf::Color::White);
-    title.setString("LEADERBOARD");
+    sf::Text& title = leaderboardTitle;
 
     //    
     {
@@ -326,16 +370,23 @@ void UIHandler::drawLeaderboard(sf::RenderWindow& window,
     float y = title.getPosition().y + 40.f;
 
     const int shown = std::min<int>(maxRows, static_cast<int>(rows.size()));
+    while (static_cast<int>(leaderboardLines.size()) < shown)
+    {
+        leaderboardLines.emplace_back();
+        leaderboardLines.back().text.setFont(font);
+        leaderboardLines.back().text.setCharacterSize(22);
+    }
+
     for (int i = 0; i < shown; ++i)
     {
         const std::pair<std::string, int>& row = rows[i];
         const std::string& name = row.first;
         int sc = row.second;
 
-        sf::Text line;
-        line.setFont(font);
-        line.setCharacterSize(22);
-        line.setString(std::to_string(i + 1) + ") " + name + " - " + std::to_string(sc));
+        //          
+        sf::Text& line = leaderboardLines[i].text;
+        setTextIfChanged(line, leaderboardLines[i].shown,
+            frameArena.format("%d) %s - %d", i + 1, name.c_str(), sc));
 
         //   Player
         if (i == highlightIndex) 
@@ -347,6 +398,7 @@ void UIHandler::drawLeaderboard(sf::RenderWindow& window,
         else 
         {
             line.setFillColor(sf::Color::White);
+            line.setOutlineThickness(0.0f);
         }
 
         auto b = line.getLocalBounds();
@@ -358,22 +410,45 @@ void UIHandler::drawLeaderboard(sf::RenderWindow& window,
     }
 }
 
+//     : "You are #12,345 (top 3%)"
+void UIHandler::drawPlayerRank(CountingRenderTarget& window, int rank, float topPercent, float y)
+{
+    initLeaderboardTexts();
+
+    //   
+    char plain[16];
+    const int length = std::snprintf(plain, sizeof(plain), "%d", rank);
+    char digits[24];
+    int out = 0;
+    for (int i = 0; i < length; ++i)
+    {
+        if (i > 0 && (length - i) % 3 == 0) digits[out++] = ',';
+        digits[out++] = plain[i];
+    }
+    digits[out] = '\0';
+
+    sf::Text& line = rankLine.text;
+    setTextIfChanged(line, rankLine.shown, frameArena.format(
+        topPercent < 1.0f ? "You are #%s (top %.1f%%)" : "You are #%s (top %.0f%%)", digits, topPercent));
+
+    auto b = line.getLocalBounds();
+    line.setOrigin(b.left + b.width / 2.f, b.top + b.height / 2.f);
+    line.setPosition(Constants::SCREEN_WIDTH / 2.f, y);
+    window.draw(line);
+}
+
 void UIHandler::drawLeaderboardScreen(
-    sf::RenderWindow& window,
+    CountingRenderTarget& window,
     const std::vector<std::pair<std::string, int>>& rows,
     int highlightIndex)
 {
+    initLeaderboardTexts();
+
     //  
-    sf::RectangleShape overlay(sf::Vector2f(Constants::SCREEN_WIDTH, Constants::SCREEN_HEIGHT));
-    overlay.setFillColor(sf::Color(0, 0, 0, 160));
-    window.draw(overlay);
+    window.draw(leaderboardOverlay);
 
     // 
-    sf::Text title;
-    title.setFont(font);
-    title.setCharacterSize(48);
-    title.setFillColor(sf::Color::White);
-    title.setString("HIGHLIGHTS");
+    sf::Text& title = highlightsTitle;
 
     auto tb = title.getLocalBounds();
     title.setOrigin(tb.left + tb.width / 2.f, tb.top + tb.height / 2.f);
@@ -390,11 +465,7 @@ void UIHandler::drawLeaderboardScreen(
     drawLeaderboard(window, rows, highlightIndex, tableStartY, /*maxRows=*/10);
 
     //  ""
-    sf::Text hint;
-    hint.setFont(font);
-    hint.setCharacterSize(20);
-    hint.setFillColor(sf::Color(200, 200, 200));
-    hint.setString("Enter / Esc - back to Main Menu ");
+    sf::Text& hint = backHint;
     auto hb = hint.getLocalBounds();
     hint.setOrigin(hb.left + hb.width / 2.f, hb.top + hb.height / 2.f);
     hint.setPosition(Constants::SCREEN_WIDTH / 2.f, tableStartY + 12 * 28.f);
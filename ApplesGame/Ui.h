@@ -17,6 +17,8 @@
 #include "Constants.h"
 #include <vector>
 #include <string>
+#include "FrameArena.h"
+#include "CountingRenderTarget.h"
 
 
 class UIHandler {
@@ -29,6 +31,7 @@ public:
         sf::Font& font; 
         sf::Sound& menuSound; 
         sf::Sound& selectSound; 
+        FrameArena& frameArena;
     };
 
     UIHandler(const MenuConfig& config);
@@ -38,22 +41,28 @@ public:
     void initMainMenu();
     void initPauseMenu();
     void updateMenuSelection(bool moveDown, MenuState type);
-    void drawMainMenu(sf::RenderWindow& window);
-    void drawPauseMenu(sf::RenderWindow& window);
+    void drawMainMenu(CountingRenderTarget& window);
+    void drawPauseMenu(CountingRenderTarget& window);
     void resetPauseMenu();
 
     int showModeSelectionMenu(sf::RenderWindow& window);
 
-    void drawLeaderboard(sf::RenderWindow& window,
+    void drawLeaderboard(CountingRenderTarget& window,
         const std::vector<std::pair<std::string, int>>& rows,
         int highlightIndex,
         float startY = 0.f,
         int maxRows = 10);
 
-    void drawLeaderboardScreen(sf::RenderWindow& window,
+    void drawPlayerRank(CountingRenderTarget& window, int rank, float topPercent, float y);
+
+    void drawLeaderboardScreen(CountingRenderTarget& window,
         const std::vector<std::pair<std::string, int>>& rows,
         int highlightIndex);
 
+    //       :   
+    // sf::Text   sf::String  
+    static void setTextIfChanged(sf::Text& text, std::string& shown, const char* value);
+
 private:
     struct Menu 
     {
@@ -68,7 +77,23 @@ private:
     sf::Font& font;
     sf::Sound& menuSound;
     sf::Sound& selectSound;
+    FrameArena& frameArena;
     sf::Clock blinkClock;
+
+    //       (   )
+    struct CachedText
+    {
+        sf::Text text;
+        std::string shown;
+    };
+    bool leaderboardTextsReady = false;
+    sf::Text leaderboardTitle;
+    std::vector<CachedText> leaderboardLines;
+    CachedText rankLine;
+    sf::RectangleShape leaderboardOverlay;
+    sf::Text highlightsTitle;
+    sf::Text backHint;
+    void initLeaderboardTexts();
     sf::Clock outlineBlinkClock;
 
     void updateMenuVisuals(Menu& menu);
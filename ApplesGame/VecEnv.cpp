@@ -0,0 +1,179 @@
+﻿#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include "VecEnv.h"
+#include "MovementSystem.h"
+
+const int VecEnv::OBSERVATION_K;
+const int VecEnv::OBSERVATION_SIZE;
+const int VecEnv::RASTER_WIDTH;
+const int VecEnv::RASTER_HEIGHT;
+const int VecEnv::RASTER_SIZE;
+
+namespace
+{
+    const float DELTA_TIME = 1.0f / 60.0f;
+    const float DEATH_REWARD = -10.0f;
+    const float WIN_REWARD = 10.0f;
+    const int MAX_EPISODE_TICKS = 60 * 60 * 3; // 3 минуты игры
+    const float MAX_PLAYER_SPEED = 300.0f;
+    const int BLOCKS_PER_THREAD = 4;           // блоки мельче потоков выравнивают нагрузку
+    const int SLOT_SIZE = 5;
+    const sf::Vector2f RASTER_VIEW(400.0f, 300.0f); // окно растра вокруг игрока
+
+    // Объект-кандидат наблюдения: смещение от игрока и два признака
+    struct Candidate
+    {
+        float distanceSq;
+        float dx, dy, a, b;
+    };
+
+    // Пишет k ближайших кандидатов в слоты out (остальные слоты - нули)
+    float* writeNearest(Candidate* candidates, int count, float* out)
+    {
+        const int k = std::min(count, static_cast<int>(VecEnv::OBSERVATION_K));
+        std::partial_sort(candidates, candidates + k, candidates + count,
+            [](const Candidate& l, const Candidate& r) { return l.distanceSq < r.distanceSq; });
+
+        const float scale = 1.0f / Constants::SCREEN_WIDTH;
+        for (int i = 0; i < VecEnv::OBSERVATION_K; ++i, out += SLOT_SIZE)
+        {
+            if (i >= k)
+            {
+                std::fill(out, out + SLOT_SIZE, 0.0f);
+                continue;
+            }
+            out[0] = 1.0f;
+            out[1] = candidates[i].dx * scale;
+            out[2] = candidates[i].dy * scale;
+            out[3] = candidates[i].a;
+            out[4] = candidates[i].b;
+        }
+        return out;
+    }
+}
+
+VecEnv::VecEnv(int envCount, int modeMask, int threadCount, bool rasterObservations)
+    : envCount(std::max(1, envCount)), modeMask(modeMask), pool(threadCount)
+{
+    blockCount = std::min(this->envCount, pool.getThreadCount() * BLOCKS_PER_THREAD);
+    states.resize(this->envCount);
+    observations.resize(static_cast<std::size_t>(this->envCount) * OBSERVATION_SIZE);
+    rewards.resize(this->envCount);
+    dones.resize(this->envCount);
+
+    if (rasterObservations)
+    {
+        rasterData.resize(static_cast<std::size_t>(this->envCount) * RASTER_SIZE);
+        rasters.assign(blockCount, OccupancyRaster(RASTER_WIDTH, RASTER_HEIGHT));
+    }
+}
+
+VecEnv::Batch VecEnv::reset(std::uint32_t seed)
+{
+    for (int i = 0; i < envCount; ++i)
+    {
+        Sim::generate(states[i], modeMask, seed + static_cast<std::uint32_t>(i));
+        rewards[i] = 0.0f;
+        dones[i] = 0;
+        writeObservation(i, rasters.empty() ? nullptr : &rasters.front());
+    }
+    return getBatch();
+}
+
+VecEnv::Batch VecEnv::step(const int* actions)
+{
+    pendingActions = actions;
+    pool.run(blockCount, &VecEnv::stepTask, this);
+    pendingActions = nullptr;
+    return getBatch();
+}
+
+VecEnv::Batch VecEnv::getBatch() const
+{
+    return { observations.data(), rewards.data(), dones.data(), rasterData.empty() ? nullptr : rasterData.data() };
+}
+
+// Блок партий подряд: соседние SimState лежат в памяти рядом
+void VecEnv::stepTask(void* context, int block)
+{
+    VecEnv& env = *static_cast<VecEnv*>(context);
+    const int begin = static_cast<int>(static_cast<long long>(env.envCount) * block / env.blockCount);
+    const int end = static_cast<int>(static_cast<long long>(env.envCount) * (block + 1) / env.blockCount);
+    OccupancyRaster* raster = env.rasters.empty() ? nullptr : &env.rasters[block];
+    for (int i = begin; i < end; ++i)
+    {
+        env.stepEnv(i, static_cast<Direction>(env.pendingActions[i] & 3), raster);
+    }
+}
+
+void VecEnv::stepEnv(int index, Direction action, OccupancyRaster* raster)
+{
+    SimState& state = states[index];
+    const int scoreBefore = state.score;
+    Sim::step(state, action, DELTA_TIME);
+
+    float reward = static_cast<float>(state.score - scoreBefore);
+    if (!state.alive) reward += DEATH_REWARD;
+    if (state.won) reward += WIN_REWARD;
+    rewards[index] = reward;
+
+    const bool done = !state.alive || state.won || state.ticks >= MAX_EPISODE_TICKS;
+    dones[index] = done ? 1 : 0;
+
+    // Следующий эпизод продолжает генератор партии: прогон воспроизводим по seed из reset()
+    if (done) Sim::generate(state, modeMask, state.random);
+
+    writeObservation(index, raster);
+}
+
+void VecEnv::writeObservation(int index, OccupancyRaster* raster)
+{
+    const SimState& state = states[index];
+    if (raster)
+    {
+        raster->setView(state.playerPosition, RASTER_VIEW);
+        raster->rasterize(state);
+        std::memcpy(&rasterData[static_cast<std::size_t>(index) * RASTER_SIZE], raster->getData(), RASTER_SIZE);
+    }
+
+    float* out = &observations[static_cast<std::size_t>(index) * OBSERVATION_SIZE];
+
+    const sf::Vector2f player = state.playerPosition;
+    *out++ = player.x / Constants::SCREEN_WIDTH;
+    *out++ = player.y / Constants::SCREEN_HEIGHT;
+    *out++ = state.playerSpeed / MAX_PLAYER_SPEED;
+    for (int i = 0; i < 4; ++i) *out++ = static_cast<int>(state.playerDirection) == i ? 1.0f : 0.0f;
+
+    Candidate candidates[Constants::NUM_APPLES + Constants::NUM_ENEMIES + Constants::NUM_OBSTACLES];
+    for (int i = 0; i < state.appleCount; ++i)
+    {
+        const sf::Vector2f delta = state.apples[i] - player;
+        candidates[i] = { delta.x * delta.x + delta.y * delta.y, delta.x, delta.y, 0.0f, 0.0f };
+    }
+    out = writeNearest(candidates, state.appleCount, out);
+
+    // Курс противника - как в Sim::step: в CHASE прямо на игрока
+    const bool chase = HasGameMode(state.modeMask, GameMode::CHASE);
+    for (int i = 0; i < state.enemyCount; ++i)
+    {
+        const sf::Vector2f delta = state.enemies[i].position - player;
+        const float distanceSq = delta.x * delta.x + delta.y * delta.y;
+        sf::Vector2f heading = directionVector(state.enemies[i].direction);
+        if (chase) heading = distanceSq > 0.0f ? -delta / std::sqrt(distanceSq) : sf::Vector2f();
+        candidates[i] = { distanceSq, delta.x, delta.y, heading.x, heading.y };
+    }
+    out = writeNearest(candidates, state.enemyCount, out);
+
+    const float sizeScale = 1.0f / Constants::SCREEN_WIDTH;
+    for (int i = 0; i < state.obstacleCount; ++i)
+    {
+        const SimState::Rect& rect = state.obstacles[i];
+        const float nearestX = std::min(std::max(player.x, rect.position.x), rect.position.x + rect.size.x);
+        const float nearestY = std::min(std::max(player.y, rect.position.y), rect.position.y + rect.size.y);
+        const sf::Vector2f delta(nearestX - player.x, nearestY - player.y);
+        candidates[i] = { delta.x * delta.x + delta.y * delta.y, delta.x, delta.y,
+            rect.size.x * sizeScale, rect.size.y * sizeScale };
+    }
+    writeNearest(candidates, state.obstacleCount, out);
+}
@@ -0,0 +1,83 @@
+﻿/*
+Векторная среда для обучения агентов: K независимых партий шагают вместе.
+
+- Состояния партий - плотный массив SimState (копия мира без SFML);
+  наблюдения, награды и признаки конца эпизода - общие плоские буферы
+  [K x размер], выделенные один раз в конструкторе: step() и reset()
+  не выделяют память.
+- Действие - номер направления Direction (0..3) на партию.
+- Наблюдение (OBSERVATION_SIZE float, координаты в долях ширины экрана):
+  игрок (x, y, скорость, направление one-hot), затем по OBSERVATION_K
+  ближайших яблок, противников и препятствий; слот объекта -
+  [есть, dx, dy, a, b]: a, b - курс противника или размер препятствия,
+  для препятствия dx, dy - до ближайшей точки прямоугольника.
+- По желанию (rasterObservations) еще и растр занятости OccupancyRaster
+  RASTER_WIDTH x RASTER_HEIGHT по каналам в окне RASTER_VIEW вокруг игрока.
+- Награда: +1 за яблоко, DEATH_REWARD за смерть, WIN_REWARD за победу.
+  Эпизод кончается смертью, победой или лимитом тиков; такая партия сразу
+  перезапускается, и в наблюдении уже первый кадр нового эпизода.
+- threadCount > 1 - партии делятся на блоки и считаются в WorkerPool;
+  результат не зависит от числа потоков.
+- C-интерфейс для привязок из других языков - ApplesEnv/apples_env.h
+  (библиотека ApplesEnv.dll).
+*/
+
+#pragma once
+#include <cstdint>
+#include <vector>
+#include "OccupancyRaster.h"
+#include "SimState.h"
+#include "WorkerPool.h"
+
+class VecEnv
+{
+public:
+    static const int OBSERVATION_K = 4;
+    static const int OBSERVATION_SIZE = 7 + 3 * OBSERVATION_K * 5;
+    static const int RASTER_WIDTH = 64;
+    static const int RASTER_HEIGHT = 48;
+    static const int RASTER_SIZE = OccupancyRaster::CHANNEL_COUNT * RASTER_WIDTH * RASTER_HEIGHT;
+
+    // Указатели на внутренние буферы, действительны до следующего step()/reset()
+    struct Batch
+    {
+        const float* observations;  // envCount * OBSERVATION_SIZE
+        const float* rewards;       // envCount
+        const std::uint8_t* dones;  // envCount
+        const std::uint8_t* rasters; // envCount * RASTER_SIZE или nullptr без растров
+    };
+
+    VecEnv(int envCount, int modeMask, int threadCount = 1, bool rasterObservations = false);
+
+    // Новые эпизоды во всех партиях: партия i получает seed + i
+    Batch reset(std::uint32_t seed);
+
+    // Один тик всех партий; actions - envCount направлений
+    Batch step(const int* actions);
+
+    // Буферы последнего step()/reset()
+    Batch getBatch() const;
+
+    int getEnvCount() const { return envCount; }
+    int getThreadCount() const { return pool.getThreadCount(); }
+    const SimState& getState(int index) const { return states[index]; }
+
+private:
+    const int envCount;
+    const int modeMask;
+    int blockCount = 1; // блоков партий на один step()
+
+    std::vector<SimState> states;
+    std::vector<float> observations;
+    std::vector<float> rewards;
+    std::vector<std::uint8_t> dones;
+    std::vector<std::uint8_t> rasterData;
+    std::vector<OccupancyRaster> rasters; // по одному на блок партий
+
+    const int* pendingActions = nullptr;
+    WorkerPool pool;
+
+    static void stepTask(void* context, int block);
+    void stepEnv(int index, Direction action, OccupancyRaster* raster);
+    void writeObservation(int index, OccupancyRaster* raster);
+};
@@ -0,0 +1,83 @@
+﻿#include <algorithm>
+#include "WorkerPool.h"
+#include "AllocationTracker.h"
+
+WorkerPool::WorkerPool(int threadCount)
+{
+    if (threadCount <= 0) threadCount = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+
+    for (int i = 1; i < threadCount; ++i)
+    {
+        workers.emplace_back(&WorkerPool::workerLoop, this);
+    }
+}
+
+WorkerPool::~WorkerPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wakeUp.notify_all();
+    for (auto& worker : workers) worker.join();
+}
+
+void WorkerPool::run(int count, Task function, void* data)
+{
+    task = function;
+    context = data;
+    taskCount = count;
+    nextIndex.store(0);
+
+    // Без рабочих (или на одну задачу) - просто цикл в вызывающем потоке
+    if (workers.empty() || count <= 1)
+    {
+        drain();
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        ++generation;
+        busyWorkers = static_cast<int>(workers.size());
+    }
+    wakeUp.notify_all();
+
+    drain();
+
+    std::unique_lock<std::mutex> lock(mutex);
+    finished.wait(lock, [this] { return busyWorkers == 0; });
+}
+
+void WorkerPool::workerLoop()
+{
+    AllocationTracker::Scope other(AllocationTracker::Subsystem::Other);
+    int seenGeneration = 0;
+    for (;;)
+    {
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            wakeUp.wait(lock, [&] { return stopping || generation != seenGeneration; });
+            if (stopping) return;
+            seenGeneration = generation;
+        }
+
+        drain();
+
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            --busyWorkers;
+        }
+        finished.notify_one();
+    }
+}
+
+void WorkerPool::drain()
+{
+    for (;;)
+    {
+        const int index = nextIndex.fetch_add(1);
+        if (index >= taskCount) return;
+        task(context, index);
+    }
+}
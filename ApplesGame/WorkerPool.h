@@ -0,0 +1,53 @@
+﻿/*
+Постоянный пул потоков для пакетных расчетов (прогоны планировщика,
+шаг пакета сред VecEnv).
+
+- run(count, task, context) вызывает task(context, i) для всех i из
+  [0, count) и возвращается, когда все вызовы завершены; вызывающий поток
+  считает вместе с рабочими.
+- Индексы раздаются через атомарный счетчик (как задачи в ResourceLoader),
+  задача - указатель на функцию и контекст: run() не выделяет память.
+- Рабочие потоки живут все время жизни пула и ждут следующего run()
+  на condition_variable.
+*/
+
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class WorkerPool
+{
+public:
+    using Task = void (*)(void* context, int index);
+
+    // threadCount - всего потоков вместе с вызывающим; 0 - по числу ядер
+    explicit WorkerPool(int threadCount);
+    ~WorkerPool();
+    WorkerPool(const WorkerPool&) = delete;
+    WorkerPool& operator=(const WorkerPool&) = delete;
+
+    void run(int count, Task task, void* context);
+
+    int getThreadCount() const { return static_cast<int>(workers.size()) + 1; }
+
+private:
+    // Задание текущего run()
+    Task task = nullptr;
+    void* context = nullptr;
+    int taskCount = 0;
+    std::atomic<int> nextIndex{ 0 };
+
+    std::vector<std::thread> workers;
+    std::mutex mutex;
+    std::condition_variable wakeUp;
+    std::condition_variable finished;
+    int generation = 0; // номер задания; меняется - рабочие берут индексы
+    int busyWorkers = 0;
+    bool stopping = false;
+
+    void workerLoop();
+    void drain();
+};
@@ -24,18 +24,16 @@
    *     
 */
 
+#include <algorithm>
+#include <cmath>
 #include <cstdlib>
 #include <ctime>
 #include "Enemy.h"
 #include "CollisionSystem.h"
 
-Enemy::Enemy()
+Enemy::Enemy(const sf::Texture& texture)
 {
-    //  
-    if (!texture.loadFromFile(Constants::RESOURCES_PATH + "enemy.png"))
-    {
-        throw std::runtime_error("Failed to load enemy texture!");
-    }
+    //         
     sprite.setTexture(texture);
 
     //  
@@ -43,13 +41,22 @@ Enemy::Enemy()
     sprite.setScale(scale, scale);
     sprite.setOrigin(texture.getSize().x / 2, texture.getSize().y / 2);
 
+    respawn();
+}
+
+//    (    ,   )
+void Enemy::respawn()
+{
     speed = Constants::INIT_SPEED * 0.8f;
     changeDirectionTime = 1.5f + (rand() % 2000) / 1000.0f;
     direction = static_cast<Direction>(rand() % 4);
-    updateRotation();
+    directionTimer.restart();
+    savedTime = sf::Time::Zero;
+    velocity = directionVector(direction) * speed;
+    sprite.setRotation(rotationFor(velocity));
 }
 
-void Enemy::update(float deltaTime, const std::vector<std::unique_ptr<Obstacle>>& obstacles)
+void Enemy::wander()
 {
     //    
     if (directionTimer.getElapsedTime().asSeconds() > changeDirectionTime)
@@ -57,23 +64,33 @@ void Enemy::update(float deltaTime, const std::vector<std::unique_ptr<Obstacle>>
         direction = static_cast<Direction>(rand() % 4);
         directionTimer.restart();
         changeDirectionTime = 1.0f + (rand() % 2000) / 1000.0f;
-        updateRotation();
     }
 
-    // 
-    switch (direction)
-    {
-    case Direction::Right: position.x += speed * deltaTime; break;
-    case Direction::Up:    position.y -= speed * deltaTime; break;
-    case Direction::Left:  position.x -= speed * deltaTime; break;
-    case Direction::Down:  position.y += speed * deltaTime; break;
-    }
+    velocity = directionVector(direction) * speed;
+}
+
+// :       
+void Enemy::chase(const FlowField& field)
+{
+    velocity = field.getDirection(position) * speed;
+}
 
+//     :      
+void Enemy::resolveMove(const SlotMap<Obstacle>& obstacles)
+{
     //  
     avoidObstacles(obstacles);
     checkBoundaries();
 }
 
+//   (  CHASE    )
+void Enemy::clampToScreen()
+{
+    const float halfSize = Constants::PLAYER_SIZE / 2.0f;
+    position.x = std::min(std::max(position.x, halfSize), Constants::SCREEN_WIDTH - halfSize);
+    position.y = std::min(std::max(position.y, halfSize), Constants::SCREEN_HEIGHT - halfSize);
+}
+
 void Enemy::checkBoundaries()
 {
     const float halfSize = Constants::PLAYER_SIZE / 2.0f;
@@ -98,11 +115,11 @@ void Enemy::checkBoundaries()
                   Constants::SCREEN_HEIGHT - halfSize : position.y;
 }
 
-void Enemy::avoidObstacles(const std::vector<std::unique_ptr<Obstacle>>& obstacles)
+void Enemy::avoidObstacles(const SlotMap<Obstacle>& obstacles)
 {
     for (const auto& obs : obstacles)
     {
-        if (Collision::circleRectCollision(*this, Constants::PLAYER_SIZE / 2, *obs, obs->getSize()))
+        if (Collision::circleRectCollision(*this, Constants::PLAYER_SIZE / 2, obs, obs.getSize()))
         {
             //       
             direction = static_cast<Direction>(rand() % 4);
@@ -111,27 +128,10 @@ void Enemy::avoidObstacles(const std::vector<std::unique_ptr<Obstacle>>& obstacl
     }
 }
 
-void Enemy::updateRotation()
-{
-    switch (direction)
-    {
-        case Direction::Right:
-            sprite.setRotation(0.f);
-            break;
-        case Direction::Up:
-            sprite.setRotation(270.f);
-            break;
-        case Direction::Left:
-            sprite.setRotation(180.f);
-            break;
-        case Direction::Down:
-            sprite.setRotation(90.f);
-            break;
-    }
-}
-
-void Enemy::draw(sf::RenderWindow& window)
+void Enemy::draw(CountingRenderTarget& window)
 {
+    //       
+    if (velocity.x != 0.0f || velocity.y != 0.0f) sprite.setRotation(rotationFor(velocity));
     sprite.setPosition(position);
     window.draw(sprite);
 }
@@ -146,8 +146,11 @@ void Enemy::pauseTimers()
     savedTime = directionTimer.getElapsedTime();
 }
 
+//       
 void Enemy::resumeTimers()
 {
+    changeDirectionTime -= savedTime.asSeconds();
+    savedTime = sf::Time::Zero;
     directionTimer.restart();
 }
 
@@ -8,7 +8,8 @@
 
  Enemy      .
  :
--  : ,    
+-  : ,    ;
+     velocity,   MovementSystem
 -   (avoidObstacles)
 -    : ,  
 -     
@@ -24,6 +25,8 @@
 
  :
 -      
+-   CHASE       (chase)
+-       
 -     getBounds()  FloatRect
 -  /  
 */
@@ -34,12 +37,17 @@
 #include "GameObjects.h"
 #include "Enums.h"
 #include "Obstacle.h"
+#include "SlotMap.h"
+#include "FlowField.h"
+#include "MovementSystem.h"
 
 class Enemy : public GameObject
 {
 public:
     float speed;
     Direction direction;
+    sf::Vector2f velocity;         //  (px/s),   MovementSystem
+    sf::Vector2f previousPosition; //     ( swept-)
     sf::RectangleShape shape;
     sf::Color color;
     sf::Clock directionTimer;
@@ -51,14 +59,16 @@ public:
     void resumeTimers();
     void setColor(const sf::Color& color);
     
-    Enemy();
-    void update(float deltaTime, const std::vector<std::unique_ptr<Obstacle>>& obstacles);
-    void draw(sf::RenderWindow& window) override;
-    void avoidObstacles(const std::vector<std::unique_ptr<Obstacle>>& obstacles);
+    explicit Enemy(const sf::Texture& texture);
+    void respawn();
+    void wander();                      //   (   )
+    void chase(const FlowField& field); //     (CHASE)
+    void resolveMove(const SlotMap<Obstacle>& obstacles); //  :   
+    void clampToScreen();
+    void draw(CountingRenderTarget& window) override;
+    void avoidObstacles(const SlotMap<Obstacle>& obstacles);
 
 private:
     sf::Time savedTime;
-    sf::Texture texture;
     sf::Sprite sprite;
-    void updateRotation();
 };
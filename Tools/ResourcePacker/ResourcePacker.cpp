@@ -0,0 +1,126 @@
+﻿/*
+Упаковщик ресурсов игры в один файл Resources.pak.
+
+Использование:
+    ResourcePacker <папка ресурсов> <выходной .pak>
+
+Проект ResourcePacker входит в решение; после сборки ApplesGame пакет
+пересобирается шагом post-build:
+    ResourcePacker.exe ApplesGame\Resources ApplesGame\Resources.pak
+
+Все файлы папки (рекурсивно) записываются в пакет с именами относительно
+нее, например "apple.wav" или "Fonts/Roboto-Bold.ttf". Формат описан
+в ApplesGame/ResourcePack.h.
+*/
+
+#include <algorithm>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <string>
+#include <vector>
+#include "../../ApplesGame/ResourcePack.h"
+
+namespace fs = std::filesystem;
+
+namespace
+{
+    struct PackedFile
+    {
+        std::string name;
+        std::uint64_t offset = 0;
+        std::uint64_t size = 0;
+        std::uint32_t crc = 0;
+    };
+
+    template <typename T>
+    void writeValue(std::ofstream& out, T value)
+    {
+        out.write(reinterpret_cast<const char*>(&value), sizeof(T));
+    }
+
+    void pad(std::ofstream& out, std::uint64_t& position)
+    {
+        while (position % PackFormat::DATA_ALIGNMENT != 0)
+        {
+            out.put('\0');
+            ++position;
+        }
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    if (argc != 3)
+    {
+        std::cerr << "Usage: ResourcePacker <resources dir> <output .pak>" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    const fs::path root = argv[1];
+    const fs::path output = argv[2];
+
+    std::vector<fs::path> paths;
+    for (const auto& item : fs::recursive_directory_iterator(root))
+    {
+        if (item.is_regular_file() && item.path() != output) paths.push_back(item.path());
+    }
+    std::sort(paths.begin(), paths.end());
+
+    std::ofstream out(output, std::ios::binary);
+    if (!out)
+    {
+        std::cerr << "Failed to create " << output << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    // Заголовок дописывается после индекса
+    std::uint64_t position = PackFormat::HEADER_SIZE;
+    out.write(std::string(PackFormat::HEADER_SIZE, '\0').data(), PackFormat::HEADER_SIZE);
+
+    std::vector<PackedFile> packed;
+    for (const auto& path : paths)
+    {
+        std::ifstream in(path, std::ios::binary);
+        std::vector<char> bytes((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+
+        PackedFile file;
+        file.name = fs::relative(path, root).generic_string();
+        file.offset = position;
+        file.size = bytes.size();
+        file.crc = Checksum::crc32(bytes.data(), bytes.size());
+
+        out.write(bytes.data(), bytes.size());
+        position += bytes.size();
+        pad(out, position);
+
+        std::cout << file.name << " (" << file.size << " bytes)" << std::endl;
+        packed.push_back(file);
+    }
+
+    const std::uint64_t indexOffset = position;
+    for (const auto& file : packed)
+    {
+        writeValue<std::uint64_t>(out, file.offset);
+        writeValue<std::uint64_t>(out, file.size);
+        writeValue<std::uint32_t>(out, file.crc);
+        writeValue<std::uint16_t>(out, static_cast<std::uint16_t>(file.name.size()));
+        out.write(file.name.data(), file.name.size());
+    }
+
+    out.seekp(0);
+    out.write(PackFormat::MAGIC, 4);
+    writeValue<std::uint32_t>(out, PackFormat::VERSION);
+    writeValue<std::uint32_t>(out, static_cast<std::uint32_t>(packed.size()));
+    writeValue<std::uint32_t>(out, static_cast<std::uint32_t>(indexOffset));
+
+    if (!out)
+    {
+        std::cerr << "Failed to write " << output << std::endl;
+        return EXIT_FAILURE;
+    }
+    std::cout << packed.size() << " files packed into " << output << std::endl;
+    return EXIT_SUCCESS;
+}